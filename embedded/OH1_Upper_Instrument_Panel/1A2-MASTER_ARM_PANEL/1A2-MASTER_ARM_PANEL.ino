@@ -86,6 +86,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 //Declare pins for DCS-BIOS per interconnect diagram.
 #define E_JETT_SW     A1 ///< Emergency Jettison Switch
@@ -101,6 +102,9 @@ DcsBios::Switch2Pos masterModeAg("MASTER_MODE_AG", AG_SW);
 DcsBios::Switch2Pos emerJettBtn("EMER_JETT_BTN", E_JETT_SW);
 DcsBios::Switch2Pos fireExtBtn("FIRE_EXT_BTN", READY_SW);
 
+// Let the host compare the master arm switch with the sim, see OHInputState.h. The buttons spring back and are not reported.
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> masterArmSwState("MASTER_ARM_SW", masterArmSw, MSTR_ARM_SW);
+
 /**
  * @brief 
 * Arduino Setup Function
@@ -126,4 +130,7 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
 }
\ No newline at end of file
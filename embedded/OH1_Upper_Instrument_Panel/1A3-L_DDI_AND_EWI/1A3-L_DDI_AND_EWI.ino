@@ -78,7 +78,7 @@
 #if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega2560__)
 #define DCSBIOS_IRQ_SERIAL ///< This enables interrupt-driven serial communication for DCS-BIOS. (Only used with the ATmega328P or ATmega2560 microcontrollers.)
 #else
-#define DCSBIOS_DEFAULT_SERIAL ///< This enables the default serial communication for DCS-BIOS. (Used with all other microcontrollers than the ATmega328P or ATmega2560.)  
+#define OH_BATCHED_SERIAL ///< This sends the DCS-BIOS commands of one loop pass in one USB packet, see OHBatchedSerial.h. (Used with all other microcontrollers than the ATmega328P or ATmega2560, replaces DCSBIOS_DEFAULT_SERIAL.)
 #endif
 
 #ifdef __AVR__
@@ -94,6 +94,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 #include "TCA9534.h"
 
 // Define pins per the OH Interconnect. 
@@ -126,7 +127,7 @@ bool lastBtnState[20]; ///< Array to hold the last state of the 20 DDI buttons.
 bool buttonState[20]; ///< Array to hold the current state of the 20 DDI buttons.
 uint8_t inputRegister[4]; ///< Input register for button read logic.
 unsigned long lastDebounceTime[20]; ///< Array to hold last time of DDI button update for debounce.
-unsigned long debounceDelay = 10;  ///< The debounce delay duration in ms, **increase if the output flickers**.
+OpenHornet::DebounceTuner<20> ddiDebounce("LEFT_DDI_PB", 0, 10);  ///< Debounce delay of the DDI buttons in ms, 10 ms until calibrated. **Run a debounce calibration if the output flickers**, see OHDebounceTuner.h.
 
 //Connect switches to DCS-BIOS 
 DcsBios::RotaryEncoder leftDdiBrtCtl("LEFT_DDI_BRT_CTL", "-3200", "+3200", LDDI_BRT_A, LDDI_BRT_B);
@@ -141,6 +142,15 @@ DcsBios::SwitchWithCover2Pos leftFireBtn("LEFT_FIRE_BTN", "LEFT_FIRE_BTN_COVER",
 const byte leftDdiBrtSelectPins[3] = { LDDI_ROT_OFF, LDDI_ROT_NIGHT, LDDI_ROT_DAY };
 DcsBios::SwitchMultiPos leftDdiBrtSelect("LEFT_DDI_BRT_SELECT", leftDdiBrtSelectPins, 3);
 
+/**
+ * @brief Times the DDI backlight against INSTR_INT_LT, see OHActuatorLatency.h.
+ *
+ * The probe and instrIntLt below both listen to 0x7560. The probe starts its clock in onConsistentData() at the end
+ * of the frame, instrIntLt applies the value later from OpenHornet::serviceLoop() and stops the clock then. The order
+ * of the two listeners therefore does not matter.
+ */
+OpenHornet::ActuatorLatencyProbe ddiBackLightActuator("DDI_BACK_LIGHT", 0x7560, 0xffff, 0);
+
 /**
  * @brief Setup DCS-BIOS control for DDI backlighting
  *
@@ -149,7 +159,8 @@ DcsBios::SwitchMultiPos leftDdiBrtSelect("LEFT_DDI_BRT_SELECT", leftDdiBrtSelect
  */
 void onInstrIntLtChange(unsigned int newValue) {
   analogWrite(DDI_BACK_LIGHT, map(newValue, 0, 65535, 0, 255));
-} DcsBios::IntegerBuffer instrIntLtBuffer(0x7560, 0xffff, 0, onInstrIntLtChange);
+}
+OpenHornet::PredictedDimmer instrIntLt(OH_DIMMER_INSTRUMENTS, 0x7560, 0xffff, 0, onInstrIntLtChange, ddiBackLightActuator);  ///< Follows the INST PNL dimmer right away when the host relays it, and stops the probe only for export values, see OHDimmer.h.
 
 /**
 * Arduino Setup Function
@@ -188,13 +199,17 @@ void setup() {
 * Arduino standard Loop Function. Code who should be executed
 * over and over in a loop, belongs in this function.
 * 
-* @attention If DDI button output flickers increase debounceDelay.
+* @attention If DDI button output flickers run a debounce calibration, see OHDebounceTuner.h.
 */
 void loop() {
+  unsigned long ddiRawState = 0;  // One bit per DDI button, for the debounce calibration.
 
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
 /**
 * Read all the DDI button states and send DCSBios Commands in the following TCA9534 order: Left, Top (buttons reversed), Right (buttons reversed), Bottom.
 *
@@ -220,12 +235,13 @@ void loop() {
       *
       */
       bool btnState = (inputRegister[i] >> (4 - j)) & 1;
+      ddiRawState |= (unsigned long)btnState << index;
 
       if (btnState != lastBtnState[index]) {
         lastDebounceTime[index] = millis();
       }
 
-      if ((millis() - lastDebounceTime[index]) > debounceDelay) {
+      if ((millis() - lastDebounceTime[index]) > ddiDebounce.delayMs()) {
         if (btnState != buttonState[index]) {
           buttonState[index] = btnState;
           char btnName[14];
@@ -236,4 +252,7 @@ void loop() {
       lastBtnState[index] = btnState;
     }
   }
+
+  // Time the bounce of every DDI button while a debounce calibration runs, they share one delay.
+  ddiDebounce.sample(ddiRawState);
 }
\ No newline at end of file
@@ -85,6 +85,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
 #define HMD_A A3 ///< HMD Brightness
@@ -119,4 +120,7 @@ void loop() {
 
   //Run DCS Bios loop function
   DcsBios::loop();
+
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
 }
\ No newline at end of file
@@ -92,6 +92,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
  #define AOA_A A0 ///< AOA Indexer
@@ -109,11 +110,11 @@
 
 // Connect switches to DCS-BIOS 
 DcsBios::Switch2Pos hudAltSw("HUD_ALT_SW", ALT_BARO);
-DcsBios::Potentiometer hudAoaIndexer("HUD_AOA_INDEXER", AOA_A);
+OpenHornet::CoalescedPotentiometer hudAoaIndexer("HUD_AOA_INDEXER", AOA_A);
 DcsBios::Switch3Pos hudAttSw("HUD_ATT_SW", ATT_STBY, ATT_INS);
-DcsBios::Potentiometer hudBalance("HUD_BALANCE", BAL_A);
-DcsBios::Potentiometer hudBlackLvl("HUD_BLACK_LVL", BLK_A);
-DcsBios::Potentiometer hudSymBrt("HUD_SYM_BRT", BRT_A);
+OpenHornet::CoalescedPotentiometer hudBalance("HUD_BALANCE", BAL_A);
+OpenHornet::CoalescedPotentiometer hudBlackLvl("HUD_BLACK_LVL", BLK_A);
+OpenHornet::CoalescedPotentiometer hudSymBrt("HUD_SYM_BRT", BRT_A);
 DcsBios::Switch2Pos hudSymBrtSelect("HUD_SYM_BRT_SELECT", DAY_SW);
 DcsBios::Switch3Pos hudSymRejSw("HUD_SYM_REJ_SW", REJ_2, REJ_NORM);
 DcsBios::Switch3Pos hudVideoControlSw("HUD_VIDEO_CONTROL_SW", WB_OFF, WB_WB);
@@ -142,4 +143,7 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
 }
\ No newline at end of file
@@ -90,6 +90,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
  #define SEAT_HARNESS_LOCK A3  ///< Seat Harness Lock - forward position
@@ -132,4 +133,7 @@ void loop() {
 
   //Run DCS Bios loop function
   DcsBios::loop();
+
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
 }
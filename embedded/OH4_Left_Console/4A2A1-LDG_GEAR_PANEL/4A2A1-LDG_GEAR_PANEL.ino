@@ -86,6 +86,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 
 // Define pins for DCS-BIOS per interconnect diagram.
@@ -109,6 +110,10 @@ DcsBios::Switch2Pos gearLever("GEAR_LEVER", LG_LIMIT);
 DcsBios::Switch2Pos gearSilenceBtn("GEAR_SILENCE_BTN", LG_WARN);
 DcsBios::LED landingGearHandleLt(0x747e, 0x0800, LG_LED);
 
+// Let the host compare the gear handles with the sim, see OHInputState.h. The buttons spring back and are not reported.
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> emergencyGearRotateState("EMERGENCY_GEAR_ROTATE", emergencyGearRotate, LG_EMERG);
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> gearLeverState("GEAR_LEVER", gearLever, LG_LIMIT);
+
 // DCSBios reads to save airplane state information.
 void onExtWowLeftChange(unsigned int newValue) {
   wowLeft = newValue;
@@ -151,6 +156,9 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
 /**
 * ### Landing Gear Down Lock Logic
 *  -# If landing gear handle in down position and lock override pushed, then activate solenoid to **unlock** handle. \n
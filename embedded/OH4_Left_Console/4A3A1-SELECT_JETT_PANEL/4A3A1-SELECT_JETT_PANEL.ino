@@ -94,6 +94,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 /**
 * @brief Pilots may want the launch bar to automatically release when the throttles advance to MIL power.
@@ -146,6 +147,9 @@ DcsBios::Switch2Pos selJettBtn("SEL_JETT_BTN", SJET_PUSH);
 const byte selJettKnobPins[5] = { SJET_SW5, SJET_SW4, SJET_SW3, SJET_SW2, SJET_SW1 };
 DcsBios::SwitchMultiPos selJettKnob("SEL_JETT_KNOB", selJettKnobPins, 5);
 
+// Time the sim's echo of the launch bar switch, read out over the service channel.
+OpenHornet::EchoLatencyProbe launchBarSwEcho("LAUNCH_BAR_SW", LBAR_SW, 0x7480, 0x2000, 13);
+
 // DCSBios reads to save airplane state information.
 
 /**
@@ -262,6 +266,9 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
 /**
  ### Launch Bar Auto Retract Logic
 *  If the launch bar mag-switch is held in extend position, then: \n
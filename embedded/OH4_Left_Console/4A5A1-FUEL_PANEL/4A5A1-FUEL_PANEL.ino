@@ -87,6 +87,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
 #define PROB_SW1 15  ///< PROBE Emergency Extend
@@ -191,6 +192,9 @@ void onIfeiFuelDownChange(char* newValue) {
     //Run DCS Bios loop function
     DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
 /**
 *   ### Fuel Dump mag-switch cancel logic:
 *   If BINGO setting value is greater than current fuel quantity, or if fuel level below critical cutoff floor of 1,950 lbs, then:
@@ -90,6 +90,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
 #define APU_SW1 15       ///< APU Mag Switch
@@ -121,6 +122,21 @@ DcsBios::Switch2Pos cbFcsChan2("CB_FCS_CHAN2", FCS_CH2);
 DcsBios::Switch2Pos cbLaunchBar("CB_LAUNCH_BAR", LCLBAR);
 DcsBios::Switch2Pos cbSpdBrk("CB_SPD_BRK", LCSPDBRK);
 
+// Let the host compare the switches with the sim, see OHInputState.h. The sim releases the magnet held switches by itself.
+const byte engineCrankSwPins[3] = { CRANK_SW2, DcsBios::PIN_NC, CRANK_SW1 };  ///< Positions of the engine crank switch, like DcsBios::Switch3Pos reads them.
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> apuControlSwState("APU_CONTROL_SW", apuControlSw, APU_SW1);
+OpenHornet::ReportedInput<DcsBios::Switch3Pos> engineCrankSwState("ENGINE_CRANK_SW", engineCrankSw, engineCrankSwPins, 3);
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> cbFcsChan1State("CB_FCS_CHAN1", cbFcsChan1, FCS_CH1);
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> cbFcsChan2State("CB_FCS_CHAN2", cbFcsChan2, FCS_CH2);
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> cbLaunchBarState("CB_LAUNCH_BAR", cbLaunchBar, LCLBAR);
+OpenHornet::ReportedInput<DcsBios::Switch2Pos> cbSpdBrkState("CB_SPD_BRK", cbSpdBrk, LCSPDBRK);
+
+// Time the sim's echo of the APU switch, read out over the service channel. The release when the sim drops the magnet is not timed.
+OpenHornet::EchoLatencyProbe apuControlSwEcho("APU_CONTROL_SW", APU_SW1, 0x74c2, 0x0100, 8);
+
+// Time the APU lamp against the APU READY light in the export stream.
+OpenHornet::ActuatorLatencyProbe apuLampActuator("APU_LAMP", 0x74c2, 0x0800, 11, APU_LAMP);
+
 // DCSBios reads to save airplane state information.
 
 /**
@@ -247,6 +263,9 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
   /**
 * ### Engine Crank Mag-Switch Logic
 *  If the engine crank mag-switch is held in an engine start position, then: \n
@@ -92,6 +92,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
 #define TO_SW1 15          ///< Take-Off Switch
@@ -195,4 +196,7 @@ void loop() {
 
   //Run DCS Bios loop function
   DcsBios::loop();
+
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
 }
\ No newline at end of file
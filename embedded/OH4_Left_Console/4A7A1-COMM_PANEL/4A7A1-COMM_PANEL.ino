@@ -106,7 +106,7 @@
  * 
  */
 #if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega2560__)
-#define DCSBIOS_IRQ_SERIAL ///< This enables interrupt-driven serial communication for DCS-BIOS. (Only used with the ATmega328P or ATmega2560 microcontrollers.)
+#define OH_ISR_EXPORT_PARSER ///< This parses the DCS-BIOS export stream in the serial interrupt, see OHIsrExportParser.h. (Only used with the ATmega328P or ATmega2560 microcontrollers, replaces DCSBIOS_IRQ_SERIAL.)
 #else
 #define DCSBIOS_DEFAULT_SERIAL ///< This enables the default serial communication for DCS-BIOS. (Used with all other microcontrollers than the ATmega328P or ATmega2560.)  
 #endif
@@ -123,6 +123,7 @@
 #define UART1_SELECT ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
  #define VOX_A A0  ///< VOX MIC COLD - HOT
@@ -171,14 +172,14 @@
 // Connect switches to DCS-BIOS 
 
 //Volume Knobs
-DcsBios::Potentiometer comAux("COM_AUX", AUX_A);
-DcsBios::Potentiometer comIcs("COM_ICS", 69);
-DcsBios::Potentiometer comMidsA("COM_MIDS_A", MIDSA_A);
-DcsBios::Potentiometer comMidsB("COM_MIDS_B", MIDSB_A);
-DcsBios::Potentiometer comRwr("COM_RWR", RWR_A);
-DcsBios::Potentiometer comTacan("COM_TACAN", TCN_A);
-DcsBios::Potentiometer comVox("COM_VOX", VOX_A);
-DcsBios::Potentiometer comWpn("COM_WPN", WPN_A);
+OpenHornet::CoalescedPotentiometer comAux("COM_AUX", AUX_A);
+OpenHornet::CoalescedPotentiometer comIcs("COM_ICS", 69);
+OpenHornet::CoalescedPotentiometer comMidsA("COM_MIDS_A", MIDSA_A);
+OpenHornet::CoalescedPotentiometer comMidsB("COM_MIDS_B", MIDSB_A);
+OpenHornet::CoalescedPotentiometer comRwr("COM_RWR", RWR_A);
+OpenHornet::CoalescedPotentiometer comTacan("COM_TACAN", TCN_A);
+OpenHornet::CoalescedPotentiometer comVox("COM_VOX", VOX_A);
+OpenHornet::CoalescedPotentiometer comWpn("COM_WPN", WPN_A);
 
 //SWITCHES
 DcsBios::Switch3Pos comCommGXmtSw("COM_COMM_G_XMT_SW", GXMT_SW1, GXMT_SW2);
@@ -230,4 +231,7 @@ void loop() {
 
   //Run DCS Bios loop function
   DcsBios::loop();
+
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
 }
@@ -88,6 +88,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 
 // Define pins for DCS-BIOS per interconnect diagram.
@@ -161,6 +162,9 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
   bool buttonState = digitalRead(OXY_FLOW_SW1);
   if (REVERSE_OXY_FLOW == true) {  // if reverse the button position move is true
     buttonState = !buttonState;    // then set button state to opposite.
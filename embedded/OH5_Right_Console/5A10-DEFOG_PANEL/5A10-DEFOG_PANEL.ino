@@ -97,6 +97,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 #include "Joystick.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
@@ -180,6 +181,10 @@ void onCanopyPosChange(unsigned int newValue) {
   }
 } DcsBios::IntegerBuffer canopyPosBuffer(0x7552, 0xffff, 0, onCanopyPosChange);
 
+// Time the release of the canopy mag-switch against the canopy position. The canopy switch also moves the
+// mag-switch, so the release is marked in loop() instead of reading the pin.
+OpenHornet::ActuatorLatencyProbe canopyMagActuator("CN_OPEN_MAG", 0x7552, 0xffff, 0);
+
 void onExtWowLeftChange(unsigned int newValue) {
   wowLeft = newValue;
 } DcsBios::IntegerBuffer extWowLeftBuffer(0x74d8, 0x0100, 8, onExtWowLeftChange);
@@ -234,6 +239,9 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
   Joystick.setButton(0, !digitalRead(CN_AUX1)); // Set the aux 1 joystick button state.
   Joystick.setButton(1, !digitalRead(CN_AUX2)); // Set the aux 2 joystick button state.
   Joystick.setXAxis(analogRead(DF_A));  // Set the defog lever position.
@@ -241,6 +249,7 @@ void loop() {
   if(canopyMagHold && canopyOpenState){ // Release mag-switch when the canopy is open and the mag is on.
     digitalWrite(CN_OPEN_MAG, LOW);  // Release the mag-switch.
     canopyMagHold = false; // Set canopy mode to false.
+    canopyMagActuator.outputChanged();
   }
 }
 
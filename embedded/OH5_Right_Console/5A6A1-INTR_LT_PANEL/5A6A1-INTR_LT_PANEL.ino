@@ -88,6 +88,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
 #define TEST A3      ///< Light Test
@@ -100,13 +101,19 @@
 #define FLOOD 10     ///< Flood Brightness
 
 // Connect switches to DCS-BIOS
-DcsBios::Potentiometer chartDimmer("CHART_DIMMER", CHART);
+OpenHornet::CoalescedPotentiometer chartDimmer("CHART_DIMMER", CHART);
 DcsBios::Switch3Pos cockkpitLightModeSw("COCKKPIT_LIGHT_MODE_SW", NVG, DAY);
-DcsBios::Potentiometer consolesDimmer("CONSOLES_DIMMER", CONSOLES);
-DcsBios::Potentiometer floodDimmer("FLOOD_DIMMER", FLOOD);
-DcsBios::Potentiometer instPnlDimmer("INST_PNL_DIMMER", INST_PNL);
+OpenHornet::CoalescedPotentiometer consolesDimmer("CONSOLES_DIMMER", CONSOLES);
+OpenHornet::CoalescedPotentiometer floodDimmer("FLOOD_DIMMER", FLOOD);
+OpenHornet::CoalescedPotentiometer instPnlDimmer("INST_PNL_DIMMER", INST_PNL);
 DcsBios::Switch2Pos lightsTestSw("LIGHTS_TEST_SW", TEST);
-DcsBios::Potentiometer warnCautionDimmer("WARN_CAUTION_DIMMER", WAR_CAUT);
+OpenHornet::CoalescedPotentiometer warnCautionDimmer("WARN_CAUTION_DIMMER", WAR_CAUT);
+
+// Send the dimmers to the host for other panels to follow before the sim does, see OHDimmer.h.
+OpenHornet::DimmerPublisher instPnlDimmerPublisher(OH_DIMMER_INSTRUMENTS, INST_PNL);
+OpenHornet::DimmerPublisher consolesDimmerPublisher(OH_DIMMER_CONSOLES, CONSOLES);
+OpenHornet::DimmerPublisher floodDimmerPublisher(OH_DIMMER_FLOOD, FLOOD);
+OpenHornet::DimmerPublisher chartDimmerPublisher(OH_DIMMER_CHART, CHART);
 
 /**
 * Arduino Setup Function
@@ -130,4 +137,7 @@ void loop() {
 
   //Run DCS Bios loop function
   DcsBios::loop();
+
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
 }
@@ -101,6 +101,7 @@
 #define UART1_SELECT    ///< Selects UART1 on Arduino for serial communication
 
 #include "DcsBios.h"
+#include "OHPanel.h"
 #include "5A7A1-SNSR_PANEL.h"
 
 // Define pins for DCS-BIOS per interconnect diagram.
@@ -136,8 +137,10 @@ DcsBios::Switch2Pos lstNflrSw("LST_NFLR_SW", LST_ON, true);
 DcsBios::Switch2Pos ltdRSw("LTD_R_SW", LTDR_ARM);
 
 ///@todo If/When https://github.com/DCS-Skunkworks/dcs-bios-arduino-library/pull/56 is accepted by DCS Skunkworks change to DcsBios::SwitchMultiPos class.
-SwitchMultiPosDebounce insSw("INS_SW", insSwPins, 8, false, 100);
-SwitchRadar radarSw("RADAR_SW", "RADAR_SW_PULL", 3, radarSwPins, 4, false, 100);
+OpenHornet::DebounceTuner<8> insDebounce("INS_SW", 0, 100, insSwPins, 8);        ///< Debounce delay of the INS knob in ms, 100 ms until calibrated, see OHDebounceTuner.h.
+OpenHornet::DebounceTuner<4> radarDebounce("RADAR_SW", 1, 100, radarSwPins, 4);  ///< Debounce delay of the radar knob in ms, 100 ms until calibrated, see OHDebounceTuner.h.
+SwitchMultiPosDebounce insSw("INS_SW", insSwPins, 8, false, insDebounce.delayMs());
+SwitchRadar radarSw("RADAR_SW", "RADAR_SW_PULL", 3, radarSwPins, 4, false, radarDebounce.delayMs());
 
 // DCSBios reads to save airplane state information.
 void onFlpLgLeftGearLtChange(unsigned int newValue) {
@@ -241,6 +244,9 @@ void loop() {
   //Run DCS Bios loop function
   DcsBios::loop();
 
+  //Run the OpenHornet service channel (host tools, see OHPanel.h)
+  OpenHornet::serviceLoop();
+
   radarSw.pollThisInput();
 
   ///@todo If/When https://github.com/DCS-Skunkworks/dcs-bios-arduino-library/pull/56 is accepted by DCS Skunkworks remove the insSw.pollThisInput(); call.
@@ -0,0 +1,205 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file COMMAND_REPLAY.ino
+ * @author OH Community
+ * @date 10.18.2026
+ * @version u.0.0.1 (untested)
+ * @copyright Copyright 2016-2024 OpenHornet. Licensed under the Apache License, Version 2.0.
+ * @warning This sketch is based on a wiring diagram, and was not yet tested on hardware.
+ * @brief Replays a pit session of DCS-BIOS commands, to load test the host bridge and DCS.
+ *
+ * @details This is a benchmark, not a panel sketch. It looks like a panel to the host: it sends the command
+ * lines from Session.h over USB serial at 250000 baud, so the bridge forwards them to DCS-BIOS or to any
+ * stand-in that counts and timestamps them. Traffic shaped like a pit session (pot streams, button presses)
+ * shows how much coalescing of commands helps. Session.h holds a synthetic session until a captured one is pasted
+ * in, see there.
+ *
+ * The serial port carries the export stream from the host, so the replay is not started by plain characters,
+ * any byte of the stream could look like one. The sketch parses the export stream like a panel, and the host
+ * writes one of these values to OH_REPLAY_CONTROL on the service channel (see OHService.h):
+ * Value | Action
+ * ----- | ---
+ * 1     | Replay at recorded speed
+ * 2     | Replay at 10 times the recorded speed
+ * 3     | Replay as fast as the serial port takes it
+ * 4     | Stop the replay
+ *
+ * At the end of each replay the sketch sends `OH_REPLAY <speed> <commands> <duration in ms> <max late in us>`,
+ * where speed is 0 for as fast as possible and max late is the worst delay of a command against its recorded time.
+ *
+ *  * **Intended Board:** Pro Micro
+ */
+
+#define DCSBIOS_DEFAULT_SERIAL  ///< Parses the export stream for the service channel, at the DCS-BIOS baud rate.
+
+#include "DcsBios.h"
+#include "OHService.h"
+#include "Session.h"
+
+#define OH_REPLAY_CONTROL 0xFF26  ///< Host writes one of the REPLAY_ values to start or stop a replay.
+#define REPLAY_RECORDED 1         ///< Replay at recorded speed.
+#define REPLAY_FAST 2             ///< Replay at 10 times the recorded speed.
+#define REPLAY_FLAT_OUT 3         ///< Replay as fast as the serial port takes it.
+#define REPLAY_STOP 4             ///< Stop the replay.
+#define LINE_LENGTH 48            ///< Longest line of the session.
+
+const char* nextLine = NULL;     ///< Next line of the session to send, NULL while no replay runs.
+byte speed = 1;                  ///< Replay speed factor, 0 for as fast as possible.
+unsigned long startMicros = 0;   ///< micros() at the start of the replay.
+unsigned int commands = 0;       ///< Commands sent in this replay.
+unsigned long maxLate = 0;       ///< Worst delay of a command against its recorded time, in us.
+
+/**
+ * Starts a replay.
+ * @param factor Speed factor, 0 for as fast as possible.
+ */
+void startReplay(byte factor) {
+  speed = factor;
+  nextLine = session;
+  startMicros = micros();
+  commands = 0;
+  maxLate = 0;
+}
+
+/**
+ * Sends the summary of the replay that just ended.
+ */
+void sendSummary() {
+  OpenHornet::ServiceReply reply;
+  reply.addNumber(speed);
+  reply.addNumber(commands);
+  reply.addNumber((micros() - startMicros) / 1000UL);
+  reply.addNumber(maxLate);
+  reply.send("OH_REPLAY");
+}
+
+/**
+ * @class ReplayControl
+ * @brief Starts and stops replays on the host's writes to OH_REPLAY_CONTROL.
+ */
+class ReplayControl : public OpenHornet::ServiceHandler {
+public:
+  unsigned int pending;  ///< REPLAY_ value still to be carried out, 0 for none.
+
+  ReplayControl() {
+    pending = 0;
+  }
+
+  virtual void onServiceWrite(unsigned int address, unsigned int value) {
+    if (address == OH_REPLAY_CONTROL && value != 0) {
+      pending = value;
+    }
+  }
+
+  virtual void serviceLoop() {
+    switch (pending) {
+      case REPLAY_RECORDED:
+        startReplay(1);
+        break;
+      case REPLAY_FAST:
+        startReplay(10);
+        break;
+      case REPLAY_FLAT_OUT:
+        startReplay(0);
+        break;
+      case REPLAY_STOP:
+        nextLine = NULL;
+        break;
+    }
+    pending = 0;
+  }
+};
+
+ReplayControl replayControl;  ///< Takes the host's replay commands.
+
+/**
+* Arduino Setup Function
+*
+* Arduino standard Setup Function. Code who should be executed
+* only once at the program start, belongs in this function.
+*/
+void setup() {
+  DcsBios::setup();
+}
+
+/**
+* Arduino Loop Function
+*
+* Arduino standard Loop Function. Code who should be executed
+* over and over in a loop, belongs in this function.
+*/
+void loop() {
+  DcsBios::loop();
+
+  //Run the OpenHornet service channel (replay control)
+  OpenHornet::serviceLoop();
+
+  if (nextLine == NULL) {
+    return;
+  }
+  if (pgm_read_byte(nextLine) == '\0') {
+    nextLine = NULL;
+    sendSummary();
+    return;
+  }
+
+  // Copy the next line out of flash, it starts with its time stamp.
+  char line[LINE_LENGTH + 1];
+  byte length = 0;
+  char c;
+  while ((c = pgm_read_byte(nextLine + length)) != '\n' && c != '\0' && length < LINE_LENGTH) {
+    line[length++] = c;
+  }
+  line[length] = '\0';
+  char* command = strchr(line, ' ');
+  if (command == NULL) {
+    nextLine += length + (c == '\n' ? 1 : 0);  // Not a command line, skip it.
+    return;
+  }
+
+  unsigned long due = 0;
+  if (speed > 0) {
+    due = (strtoul(line, NULL, 10) * 1000UL) / speed;
+  }
+  unsigned long now = micros() - startMicros;
+  if (now < due) {
+    return;
+  }
+
+  Serial.print(command + 1);
+  Serial.print("\n");
+  commands++;
+  maxLate = max(maxLate, now - due);
+  nextLine += length + (c == '\n' ? 1 : 0);
+}
@@ -0,0 +1,115 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file Session.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Pit session replayed by COMMAND_REPLAY.ino.
+ *
+ * One command per line: `<time in ms since the start> <command> <argument>`. The lines below are a synthetic
+ * session, written by hand and not captured from a pit. They follow the pattern of one: master arm, left DDI
+ * presses, the pot streams of the COMM panel (COM_VOX, COM_ICS) and encoder steps. The timing is only modeled
+ * on real use. For numbers that stand for a real pit, capture a session: log the command lines of the panels
+ * with a timestamp in ms and paste them here.
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "Arduino.h"
+
+/// The synthetic session, kept in flash.
+const char session[] PROGMEM =
+    "0 MASTER_ARM_SW 1\n"
+    "850 MASTER_MODE_AG 1\n"
+    "1030 MASTER_MODE_AG 0\n"
+    "1630 LEFT_DDI_PB_07 1\n"
+    "1770 LEFT_DDI_PB_07 0\n"
+    "2370 LEFT_DDI_PB_13 1\n"
+    "2510 LEFT_DDI_PB_13 0\n"
+    "3110 LEFT_DDI_PB_05 1\n"
+    "3250 LEFT_DDI_PB_05 0\n"
+    "4150 COM_VOX 20000\n"
+    "4156 COM_VOX 21100\n"
+    "4162 COM_VOX 22200\n"
+    "4168 COM_VOX 23300\n"
+    "4174 COM_VOX 24400\n"
+    "4180 COM_VOX 25500\n"
+    "4186 COM_VOX 26600\n"
+    "4192 COM_VOX 27700\n"
+    "4198 COM_VOX 28800\n"
+    "4204 COM_VOX 29900\n"
+    "4210 COM_VOX 31000\n"
+    "4216 COM_VOX 32100\n"
+    "4222 COM_VOX 33200\n"
+    "4228 COM_VOX 34300\n"
+    "4234 COM_VOX 35400\n"
+    "4240 COM_VOX 36500\n"
+    "4246 COM_VOX 37600\n"
+    "4252 COM_VOX 38700\n"
+    "4258 COM_VOX 39800\n"
+    "4264 COM_VOX 40900\n"
+    "4270 COM_VOX 42000\n"
+    "4276 COM_VOX 43100\n"
+    "4282 COM_VOX 44200\n"
+    "4288 COM_VOX 45300\n"
+    "4294 COM_VOX 46400\n"
+    "4694 COM_ICS 41000\n"
+    "4700 COM_ICS 40100\n"
+    "4706 COM_ICS 39200\n"
+    "4712 COM_ICS 38300\n"
+    "4718 COM_ICS 37400\n"
+    "4724 COM_ICS 36500\n"
+    "4730 COM_ICS 35600\n"
+    "4736 COM_ICS 34700\n"
+    "4742 COM_ICS 33800\n"
+    "4748 COM_ICS 32900\n"
+    "4754 COM_ICS 32000\n"
+    "4760 COM_ICS 31100\n"
+    "4766 COM_ICS 30200\n"
+    "4772 COM_ICS 29300\n"
+    "4778 COM_ICS 28400\n"
+    "4784 COM_ICS 27500\n"
+    "4790 COM_ICS 26600\n"
+    "5490 COM_ILS_CHANNEL_SW 5\n"
+    "5740 COM_ILS_CHANNEL_SW 6\n"
+    "6040 LEFT_DDI_BRT_CTL +3200\n"
+    "6080 LEFT_DDI_BRT_CTL +3200\n"
+    "6120 LEFT_DDI_BRT_CTL +3200\n"
+    "6920 MASTER_CAUTION_RESET_SW 1\n"
+    "7040 MASTER_CAUTION_RESET_SW 0\n"
+    "8540 MASTER_ARM_SW 0\n"
+    ;
+
+#endif
@@ -0,0 +1,212 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file EXPORT_LOAD_GENERATOR.ino
+ * @author OH Community
+ * @date 10.18.2026
+ * @version u.0.0.1 (untested)
+ * @copyright Copyright 2016-2024 OpenHornet. Licensed under the Apache License, Version 2.0.
+ * @warning This sketch is based on a wiring diagram, and was not yet tested on hardware.
+ * @brief Stands in for DCS and sends a synthetic export stream to a panel, to load test it.
+ *
+ * @details This is a benchmark, not a panel sketch. It sends export frames built by OpenHornet::ExportGenerator
+ * on its UART, wired to the RX pin of the panel under test, at the DCS-BIOS baud rate of 250000.
+ * Open the serial monitor on USB at 115200 baud. Once per second the sketch prints the frames and bytes sent
+ * per second, and how late the frames started against the set frame rate (median, 99th percentile, maximum).
+ * Frames that started a whole period late are counted as skipped.
+ *
+ * Send one of these characters over the serial monitor to change the load:
+ * Key | Action
+ * --- | ---
+ * c   | Start the cold start scenario
+ * l   | Start the catapult launch scenario
+ * t   | Start the trap scenario
+ * +   | Frame rate up by 10 Hz, up to 120 Hz
+ * -   | Frame rate down by 10 Hz, down to 30 Hz
+ * n   | 4 more random words per frame
+ * m   | 4 less random words per frame
+ * s   | Toggle IFEI string churn
+ *
+ *  * **Intended Board:** Pro Micro
+ *
+ * ### Wiring diagram:
+ * PIN | Function
+ * --- | ---
+ * TX  | RX of the panel under test (or the A input of an RS-485 transceiver)
+ * GND | GND of the panel under test
+ */
+
+#include "OHLatencyHistogram.h"
+#include "OHExportGenerator.h"
+
+#define EXPORT_BAUD 250000  ///< Baud rate of the DCS-BIOS export stream.
+#define FRAME_RATE 30       ///< Frame rate at the start in Hz, DCS-BIOS sends 30 frames per second.
+#define NOISE_WORDS 8       ///< Random words per frame at the start.
+
+/**
+ * Writes one byte of the stream to the panel under test.
+ */
+void sendToPanel(byte b) {
+  Serial1.write(b);
+}
+
+OpenHornet::ExportGenerator generator(sendToPanel);  ///< Builds the export stream.
+OpenHornet::LatencyHistogram lateness;               ///< How late each frame started, in us.
+
+byte frameRate = FRAME_RATE;    ///< Frames per second.
+byte noiseWords = NOISE_WORDS;  ///< Random words per frame.
+bool stringChurn = true;        ///< True if the IFEI fuel display changes every frame.
+unsigned long nextFrame = 0;    ///< micros() when the next frame is due.
+unsigned int skipped = 0;       ///< Frames skipped since the last report.
+unsigned long lastReport = 0;   ///< millis() of the last report.
+unsigned int lastFrames = 0;    ///< Frames sent at the last report.
+unsigned long lastBytes = 0;    ///< Bytes sent at the last report.
+
+/**
+ * Handles a key sent over the serial monitor.
+ */
+void handleKey(char key) {
+  switch (key) {
+    case 'c':
+      generator.startScenario(OpenHornet::OH_SCENARIO_COLD_START, sizeof(OpenHornet::OH_SCENARIO_COLD_START) / sizeof(OpenHornet::ExportScenarioStep));
+      break;
+    case 'l':
+      generator.startScenario(OpenHornet::OH_SCENARIO_CAT_LAUNCH, sizeof(OpenHornet::OH_SCENARIO_CAT_LAUNCH) / sizeof(OpenHornet::ExportScenarioStep));
+      break;
+    case 't':
+      generator.startScenario(OpenHornet::OH_SCENARIO_TRAP, sizeof(OpenHornet::OH_SCENARIO_TRAP) / sizeof(OpenHornet::ExportScenarioStep));
+      break;
+    case '+':
+      frameRate = min(frameRate + 10, 120);
+      break;
+    case '-':
+      frameRate = max(frameRate - 10, 30);
+      break;
+    case 'n':
+      noiseWords = min(noiseWords + 4, 200);
+      break;
+    case 'm':
+      noiseWords = (noiseWords > 4) ? noiseWords - 4 : 0;
+      break;
+    case 's':
+      stringChurn = !stringChurn;
+      break;
+    default:
+      return;
+  }
+  generator.setNoise(noiseWords);
+  generator.setStringChurn(stringChurn);
+  lateness.clear();
+}
+
+/**
+ * Prints the results of the last second and starts a new one.
+ */
+void report() {
+  unsigned long now = millis();
+  unsigned long elapsed = now - lastReport;
+  unsigned long frames = generator.framesSent() - lastFrames;
+  unsigned long bytes = generator.bytesSent() - lastBytes;
+
+  Serial.print(frameRate);
+  Serial.print(" Hz set, ");
+  Serial.print(noiseWords);
+  Serial.print(" random words, churn ");
+  Serial.print(stringChurn ? "on" : "off");
+  Serial.print(generator.scenarioDone() ? "" : ", scenario running");
+  Serial.print(" | sent ");
+  Serial.print(frames * 1000UL / elapsed);
+  Serial.print(" frames/s, ");
+  Serial.print(bytes * 1000UL / elapsed);
+  Serial.print(" bytes/s, ");
+  Serial.print(skipped);
+  Serial.print(" skipped | late p50 ");
+  Serial.print(lateness.percentile(50));
+  Serial.print(" us, p99 ");
+  Serial.print(lateness.percentile(99));
+  Serial.print(" us, max ");
+  Serial.print(lateness.maximum());
+  Serial.println(" us");
+
+  lastReport = now;
+  lastFrames = generator.framesSent();
+  lastBytes = generator.bytesSent();
+  skipped = 0;
+  lateness.clear();
+}
+
+/**
+* Arduino Setup Function
+*
+* Arduino standard Setup Function. Code who should be executed
+* only once at the program start, belongs in this function.
+*/
+void setup() {
+  Serial.begin(115200);
+  Serial1.begin(EXPORT_BAUD);
+  generator.setNoise(noiseWords);
+  generator.setStringChurn(stringChurn);
+  handleKey('c');
+  nextFrame = micros();
+  lastReport = millis();
+}
+
+/**
+* Arduino Loop Function
+*
+* Arduino standard Loop Function. Code who should be executed
+* over and over in a loop, belongs in this function.
+*/
+void loop() {
+  if (Serial.available() > 0) {
+    handleKey(Serial.read());
+  }
+
+  unsigned long late = micros() - nextFrame;
+  if ((long)late >= 0) {
+    unsigned long period = 1000000UL / frameRate;
+    if (late >= period) {
+      // More than a whole frame behind, the link can not keep up with the load.
+      skipped += late / period;
+      nextFrame += (late / period) * period;
+      late %= period;
+    }
+    lateness.add(late);
+    nextFrame += period;
+    generator.sendFrame();
+  }
+
+  if (millis() - lastReport >= 1000) {
+    report();
+  }
+}
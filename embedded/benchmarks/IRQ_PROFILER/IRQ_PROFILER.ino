@@ -0,0 +1,120 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file IRQ_PROFILER.ino
+ * @author OH Community
+ * @date 10.18.2026
+ * @version u.0.0.1 (untested)
+ * @copyright Copyright 2016-2024 OpenHornet. Licensed under the Apache License, Version 2.0.
+ * @warning This sketch is based on a wiring diagram, and was not yet tested on hardware.
+ * @brief Builds and checks the interrupt latency profiler of OHIrqProfiler.h.
+ *
+ * @details This is a benchmark, not a panel sketch. The Makefile builds it with OH_IRQ_PROFILER, so the profiler's
+ * timer interrupt is compiled for the Pro Micro here and for the Mega 2560 in IRQ_PROFILER_2560.
+ *
+ * The sketch runs a few DCS-BIOS inputs and listeners like a small panel. Every BLOCK_EVERY_MS it also turns
+ * interrupts off for BLOCK_US, longer than OH_IRQ_BUDGET_US, in blockInterrupts(). Feed it an export stream from
+ * DCS or EXPORT_LOAD_GENERATOR and have the host write OH_LATENCY_REPORT. The OH_IRQ line must count waits over
+ * budget, and the first OH_IRQ_PC line must point into blockInterrupts() with a max close to BLOCK_US. Look the
+ * address up with `avr-addr2line -e build/IRQ_PROFILER.elf <address>`. Set BLOCK_US to 0 to profile the rest alone.
+ *
+ *  * **Intended Board:** Pro Micro (IRQ_PROFILER_2560 for the Mega 2560)
+ */
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega2560__)
+#define DCSBIOS_IRQ_SERIAL  ///< This enables interrupt-driven serial communication for DCS-BIOS. (Only used with the ATmega328P or ATmega2560 microcontrollers.)
+#else
+#define DCSBIOS_DEFAULT_SERIAL  ///< This enables the default serial communication for DCS-BIOS. (Used with all other microcontrollers than the ATmega328P or ATmega2560.)
+#endif
+
+#ifndef OH_IRQ_PROFILER
+#define OH_IRQ_PROFILER  ///< Set by the Makefile, defined here too for builds from the Arduino IDE.
+#endif
+
+#include "DcsBios.h"
+#include "OHPanel.h"
+
+#define BLOCK_US 120        ///< Time interrupts are kept off in blockInterrupts(), 0 to skip it.
+#define BLOCK_EVERY_MS 250  ///< Time between two calls of blockInterrupts().
+
+unsigned long lastBlock = 0;  ///< millis() of the last call of blockInterrupts().
+
+// A few inputs and listeners, so the profile looks like a small panel.
+DcsBios::Switch2Pos masterArmSw("MASTER_ARM_SW", 2);
+DcsBios::Switch2Pos fireExtBtn("FIRE_EXT_BTN", 3);
+DcsBios::LED masterModeAaLt(0x740c, 0x0200, 7);
+
+/**
+ * Callback of the instrument light listener, pin 6 is not on the profiler's timer.
+ */
+void onInstrIntLtChange(unsigned int newValue) {
+  analogWrite(6, map(newValue, 0, 65535, 0, 255));
+}
+DcsBios::IntegerBuffer instrIntLtBuffer(0x7560, 0xffff, 0, onInstrIntLtChange);
+
+/**
+ * Keeps interrupts off for BLOCK_US, a known culprit the profile must find.
+ */
+void __attribute__((noinline)) blockInterrupts() {
+  noInterrupts();
+  delayMicroseconds(BLOCK_US);
+  interrupts();
+}
+
+/**
+* Arduino Setup Function
+*
+* Arduino standard Setup Function. Code who should be executed
+* only once at the program start, belongs in this function.
+*/
+void setup() {
+  DcsBios::setup();
+}
+
+/**
+* Arduino Loop Function
+*
+* Arduino standard Loop Function. Code who should be executed
+* over and over in a loop, belongs in this function.
+*/
+void loop() {
+  DcsBios::loop();
+
+  //Run the OpenHornet service channel (profiler reports)
+  OpenHornet::serviceLoop();
+
+  if (BLOCK_US > 0 && millis() - lastBlock >= BLOCK_EVERY_MS) {
+    lastBlock = millis();
+    blockInterrupts();
+  }
+}
@@ -0,0 +1,266 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file PANEL_SCALING.ino
+ * @author OH Community
+ * @date 10.18.2026
+ * @version u.0.0.1 (untested)
+ * @copyright Copyright 2016-2024 OpenHornet. Licensed under the Apache License, Version 2.0.
+ * @warning This sketch is based on a wiring diagram, and was not yet tested on hardware.
+ * @brief Grows a synthetic panel from 8 to 256 DCS-BIOS objects and measures where it stops keeping up.
+ *
+ * @details This is a benchmark, not a panel sketch. It creates DCS-BIOS inputs and export listeners in blocks of
+ * SCALE_BLOCK objects, mixed like a real panel (Switch2Pos, SwitchMultiPos, Potentiometer, IntegerBuffer,
+ * StringBuffer, see the SCALE_ defines). It starts with one block and doubles the object count every
+ * SCALE_STEP_MS, up to SCALE_MAX_OBJECTS. After each step it sends:
+ *
+ *     OH_SCALE <objects> <loop p50> <loop p99> <loop max> <free RAM> <frames/s> <missed frames>
+ *
+ * with loop times in microseconds and free RAM in bytes. Missed frames are gaps in the update counter, the low byte
+ * of the word at 0xFFFE (the high byte is DCS-BIOS's skip counter). The counter wraps at 256, so a gap of 256 frames
+ * or more in one go is not seen.
+ * The sweep ends with `OH_SCALE_END <objects> <free RAM>`, early if the next block would leave less than
+ * SCALE_RAM_RESERVE bytes of RAM. The lines are plain DCS-BIOS commands, so they show in any serial monitor
+ * and the OH_SCALE lines can be pasted into a spreadsheet to plot loop time, RAM and missed frames over objects.
+ * Reset the board to run the sweep again.
+ *
+ * The export stream comes from DCS, or from EXPORT_LOAD_GENERATOR wired to the RX pin. Raise the generator's
+ * frame rate and change density until frames are missed to find the highest export rate the panel sustains at
+ * each size. Build the sketch for the Pro Micro and for the Mega 2560 (see the Makefile) to compare the boards.
+ *
+ * The pins are only read, nothing has to be wired to them. The switch pins have their pull-ups on, and setup()
+ * turns on the pull-ups of the potentiometer pins A0 - A3 too, so they read a steady 1023 instead of floating and
+ * sending commands. Ground them, or wire real potentiometers, to measure something else. The inputs read the same
+ * pins over and over, which costs the same time as reading different pins.
+ *
+ *  * **Intended Board:** Pro Micro or Mega 2560
+ */
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega2560__)
+#define DCSBIOS_IRQ_SERIAL  ///< This enables interrupt-driven serial communication for DCS-BIOS. (Only used with the ATmega328P or ATmega2560 microcontrollers.)
+#else
+#define DCSBIOS_DEFAULT_SERIAL  ///< This enables the default serial communication for DCS-BIOS. (Used with all other microcontrollers than the ATmega328P or ATmega2560.)
+#endif
+
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHLatencyHistogram.h"
+
+#define SCALE_SWITCH2POS 3     ///< Switch2Pos inputs per block.
+#define SCALE_MULTIPOS 1       ///< SwitchMultiPos inputs per block.
+#define SCALE_POTS 1           ///< Potentiometer inputs per block.
+#define SCALE_INTEGERS 2       ///< IntegerBuffer listeners per block.
+#define SCALE_STRINGS 1        ///< StringBuffer listeners per block.
+#define SCALE_BLOCK (SCALE_SWITCH2POS + SCALE_MULTIPOS + SCALE_POTS + SCALE_INTEGERS + SCALE_STRINGS)  ///< Objects per block.
+#define SCALE_MAX_OBJECTS 256  ///< The sweep ends at this many objects.
+#define SCALE_STEP_MS 10000    ///< Measuring time of each step.
+#define SCALE_RAM_RESERVE 256  ///< RAM left for the stack, the sweep ends before going below it.
+#define SCALE_STRING_LENGTH 8  ///< Length of each StringBuffer, like the IFEI digits.
+#define SCALE_FIRST_ADDRESS 0x8000  ///< The listeners use the 256 words from here on, where EXPORT_LOAD_GENERATOR puts its random words (OH_NOISE_FIRST_ADDRESS).
+
+const byte switchPins[] = { 2, 3, 4, 5, 6, 7, 8, 9 };              ///< Pins read by the Switch2Pos inputs.
+const byte multiPosPins[] = { DcsBios::PIN_NC, 2, 3, 4, 5, 6 };    ///< Pins read by each SwitchMultiPos input.
+const byte potPins[] = { A0, A1, A2, A3 };                         ///< Pins read by the Potentiometer inputs.
+
+unsigned int objects = 0;            ///< Objects created so far.
+unsigned int target = SCALE_BLOCK;   ///< Objects of the current step.
+bool done = false;                   ///< True once the sweep ended.
+unsigned long stepStart = 0;         ///< millis() at the start of the step.
+unsigned long lastLoop = 0;          ///< micros() at the start of the last loop pass.
+unsigned int updates = 0;            ///< Listener callbacks, keeps the compiler from dropping them.
+OpenHornet::LatencyHistogram loopTime;  ///< Loop pass times of the step, in us.
+
+/**
+ * @class FrameCounter
+ * @brief Counts export frames and gaps in the frame counter.
+ */
+class FrameCounter : public DcsBios::ExportStreamListener {
+public:
+  unsigned int frames;     ///< Frames received in the step.
+  unsigned int missed;     ///< Frames missing in the step.
+  byte lastValue;          ///< Last value of the update counter.
+  bool seen;               ///< True once a frame counter was received.
+
+  FrameCounter() : DcsBios::ExportStreamListener(0xFFFE, 0xFFFE) {
+    frames = 0;
+    missed = 0;
+    lastValue = 0;
+    seen = false;
+  }
+
+  virtual void onDcsBiosWrite(unsigned int address, unsigned int value) {
+    byte counter = value & 0xFF;  // Update counter, the high byte counts skipped frames.
+    if (seen == true) {
+      missed += (byte)(counter - lastValue - 1);
+    }
+    lastValue = counter;
+    seen = true;
+    frames++;
+  }
+};
+
+FrameCounter frameCounter;  ///< Counts the frames of the export stream.
+
+/**
+ * Callback of the IntegerBuffer listeners.
+ */
+void onInteger(unsigned int newValue) {
+  updates++;
+}
+
+/**
+ * Callback of the StringBuffer listeners.
+ */
+void onString(char* newValue) {
+  updates++;
+}
+
+/**
+ * @return Free RAM between the heap and the stack, in bytes.
+ */
+int freeRam() {
+#ifdef __AVR__
+  extern char __heap_start, *__brkval;
+  char top;
+  return &top - (__brkval == 0 ? &__heap_start : __brkval);
+#else
+  return 0;
+#endif
+}
+
+/**
+ * Creates one block of objects. The export listeners are spread over the addresses of EXPORT_LOAD_GENERATOR's random words.
+ */
+void addBlock() {
+  for (byte i = 0; i < SCALE_SWITCH2POS; i++) {
+    new DcsBios::Switch2Pos("OH_SCALE_SW", switchPins[(objects + i) % sizeof(switchPins)]);
+  }
+  for (byte i = 0; i < SCALE_MULTIPOS; i++) {
+    new DcsBios::SwitchMultiPos("OH_SCALE_MULTI", multiPosPins, sizeof(multiPosPins));
+  }
+  for (byte i = 0; i < SCALE_POTS; i++) {
+    new DcsBios::Potentiometer("OH_SCALE_POT", potPins[(objects + i) % sizeof(potPins)]);
+  }
+  for (byte i = 0; i < SCALE_INTEGERS; i++) {
+    new DcsBios::IntegerBuffer(SCALE_FIRST_ADDRESS + 2 * ((objects + i) % 256), 0xFFFF, 0, onInteger);
+  }
+  for (byte i = 0; i < SCALE_STRINGS; i++) {
+    new DcsBios::StringBuffer<SCALE_STRING_LENGTH>(SCALE_FIRST_ADDRESS + 2 * ((objects * 3 + i) % 256), onString);
+  }
+  objects += SCALE_BLOCK;
+}
+
+/**
+ * Sends the results of the step.
+ */
+void report() {
+  OpenHornet::ServiceReply reply;
+  reply.addNumber(objects);
+  reply.addNumber(loopTime.percentile(50));
+  reply.addNumber(loopTime.percentile(99));
+  reply.addNumber(loopTime.maximum());
+  reply.addNumber(freeRam());
+  reply.addNumber(frameCounter.frames * 1000UL / SCALE_STEP_MS);
+  reply.addNumber(frameCounter.missed);
+  reply.send("OH_SCALE");
+}
+
+/**
+ * Ends the sweep.
+ */
+void finish() {
+  OpenHornet::ServiceReply reply;
+  reply.addNumber(objects);
+  reply.addNumber(freeRam());
+  reply.send("OH_SCALE_END");
+  done = true;
+}
+
+/**
+ * Grows the panel to the object count of the step, or ends the sweep.
+ */
+void startStep() {
+  while (objects < target) {
+    if (freeRam() < SCALE_RAM_RESERVE + SCALE_BLOCK * 32) {  // Roughly the size of a block, with the heap overhead.
+      finish();
+      return;
+    }
+    addBlock();
+  }
+  loopTime.clear();
+  frameCounter.frames = 0;
+  frameCounter.missed = 0;
+  stepStart = millis();
+  lastLoop = micros();
+}
+
+/**
+* Arduino Setup Function
+*
+* Arduino standard Setup Function. Code who should be executed
+* only once at the program start, belongs in this function.
+*/
+void setup() {
+  for (byte i = 0; i < sizeof(potPins); i++) {
+    pinMode(potPins[i], INPUT_PULLUP);  // Unwired analog pins float and would send a command on every poll.
+  }
+  DcsBios::setup();
+  startStep();
+}
+
+/**
+* Arduino Loop Function
+*
+* Arduino standard Loop Function. Code who should be executed
+* over and over in a loop, belongs in this function.
+*/
+void loop() {
+  DcsBios::loop();
+
+  unsigned long now = micros();
+  loopTime.add(now - lastLoop);
+  lastLoop = now;
+
+  if (done == false && millis() - stepStart >= SCALE_STEP_MS) {
+    report();
+    if (target >= SCALE_MAX_OBJECTS) {
+      finish();
+    } else {
+      target *= 2;
+      if (target > SCALE_MAX_OBJECTS) {
+        target = SCALE_MAX_OBJECTS;
+      }
+      startStep();
+    }
+  }
+}
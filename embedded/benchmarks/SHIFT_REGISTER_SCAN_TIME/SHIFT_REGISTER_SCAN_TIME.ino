@@ -0,0 +1,122 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software' 
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file SHIFT_REGISTER_SCAN_TIME.ino
+ * @author OH Community
+ * @date 10.18.2026
+ * @version u.0.0.1 (untested)
+ * @copyright Copyright 2016-2024 OpenHornet. Licensed under the Apache License, Version 2.0.
+ * @warning This sketch is based on a wiring diagram, and was not yet tested on hardware.
+ * @brief Compares the scan time of a 74HC165 shift register chain with the same number of digitalRead() calls.
+ *
+ * @details This is a benchmark, not a panel sketch. It does not talk to DCS-BIOS.
+ * Open the serial monitor at 115200 baud. Once per second the sketch prints the average time of
+ * one ShiftRegisterChain::scan() and of reading the same number of inputs with digitalRead().
+ *
+ *  * **Intended Board:** Pro Micro with a chain of 8 74HC165 chips (64 inputs)
+ *
+ * ### Wiring diagram:
+ * PIN | Function
+ * --- | ---
+ * 10  | 74HC165 PL (load)
+ * 14  | 74HC165 QH (MISO)
+ * 15  | 74HC165 CP (SCK)
+ */
+
+#define DCSBIOS_DEFAULT_SERIAL  ///< The switch classes in the OpenHornet library need DCS-BIOS, even though this sketch does not use it.
+
+#include "DcsBios.h"
+#include "OHShiftRegisterInput.h"
+
+#define SR_LOAD 10          ///< 74HC165 PL (load)
+#define SR_CHIPS 8          ///< Number of chips in the chain.
+#define SAMPLES 100         ///< Number of scans averaged for each result, micros() only counts in steps of 4 us.
+
+/// GPIO pins that are read to compare with the chain. They are read over and over until the same number of inputs is reached.
+const byte gpioPins[] = { 2, 3, 4, 5, 6, 7, 8, 9, A0, A1, A2, A3 };
+
+OpenHornet::ShiftRegisterChain srChain(SR_LOAD, SR_CHIPS);  ///< The chain under test.
+
+/**
+* Arduino Setup Function
+*
+* Arduino standard Setup Function. Code who should be executed
+* only once at the program start, belongs in this function.
+*/
+void setup() {
+  Serial.begin(115200);
+  srChain.begin();
+
+  // Set the GPIO pins up like the DCS-BIOS switch classes do.
+  for (byte i = 0; i < sizeof(gpioPins); i++) {
+    pinMode(gpioPins[i], INPUT_PULLUP);
+  }
+}
+
+/**
+* Arduino Loop Function
+*
+* Arduino standard Loop Function. Code who should be executed
+* over and over in a loop, belongs in this function.
+*/
+void loop() {
+  unsigned int inputs = srChain.numberOfInputs();
+  byte sink = 0;  // Keeps the compiler from removing the digitalRead() calls.
+
+  // Time SAMPLES scans of the whole chain.
+  unsigned long start = micros();
+  for (int sample = 0; sample < SAMPLES; sample++) {
+    srChain.scan();
+  }
+  unsigned long chainTime = micros() - start;
+
+  // Time SAMPLES passes of the same number of digitalRead() calls.
+  start = micros();
+  for (int sample = 0; sample < SAMPLES; sample++) {
+    for (unsigned int i = 0; i < inputs; i++) {
+      sink ^= digitalRead(gpioPins[i % sizeof(gpioPins)]);
+    }
+  }
+  unsigned long gpioTime = micros() - start;
+
+  Serial.print("inputs: ");
+  Serial.print(inputs);
+  Serial.print("  shift register scan: ");
+  Serial.print(chainTime / SAMPLES);
+  Serial.print(" us  digitalRead: ");
+  Serial.print(gpioTime / SAMPLES);
+  Serial.print(" us");
+  Serial.println(sink == 0xFF ? " " : "");
+
+  delay(1000);
+}
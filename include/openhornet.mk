@@ -1 +1,7 @@
 RELEASE_DIR        = $(ROOTDIR)/release
+
+# Identify the firmware to host tools (see OHIdentity.h in the OpenHornet library)
+OH_BUILD_ID        := $(shell git -C $(ROOTDIR) describe --always --dirty 2>/dev/null || echo unknown)
+OH_ID_FLAGS        = -DOH_SKETCH_NAME=\"$(notdir $(CURDIR))\" -DOH_BUILD_ID=\"$(OH_BUILD_ID)\"
+CPPFLAGS          += $(OH_ID_FLAGS)
+BUILD_EXTRA_FLAGS += $(OH_ID_FLAGS)
@@ -0,0 +1,204 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHActuatorLatency.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Measures how long a panel takes from an export change to the output that acts on it.
+ *
+ * DCS-BIOS data is only consistent at the end of an export frame, so that is where an ActuatorLatencyProbe starts
+ * its clock: at the end of a frame in which its export value changed (the APU READY light at 0x74c2, INSTR_INT_LT at
+ * 0x7560, the canopy position at 0x7552). The clock stops when the output acting on the change moves (APU_LAMP,
+ * DDI_BACK_LIGHT, CN_OPEN_MAG). Together with the echo probes this splits the lag of a panel into the sim and the
+ * panel's own share.
+ *
+ * The output is found in one of two ways:
+ * - **A digital output pin:** the probe reads the pin on every serviceLoop() and stops when its level changes. The result
+ *   is exact to one loop pass.
+ * - **Any other output** (PWM, servo, display): the sketch calls outputChanged() right after it updates the output.
+ *
+ * If the value changes again before the output moves, the clock starts over at the newer frame. A change that moves no
+ * output within OH_ACTUATOR_TIMEOUT_MS is dropped, many changes (a canopy moving) only move the output at one point.
+ *
+ * A write to OH_LATENCY_REPORT makes every probe reply once with all times in microseconds:
+ *
+ *     OH_ACTUATOR <name> <count> <p50> <p90> <p99> <max>
+ */
+
+#ifndef OH_ACTUATOR_LATENCY_H
+#define OH_ACTUATOR_LATENCY_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHLatencyHistogram.h"
+
+#ifndef OH_ACTUATOR_TIMEOUT_MS
+#define OH_ACTUATOR_TIMEOUT_MS 1000  ///< A change that moves no output within this time is dropped.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class ActuatorLatencyProbe
+ * @brief Times one output against the export value that drives it.
+ */
+class ActuatorLatencyProbe : public ServiceHandler, public DcsBios::ExportStreamListener {
+private:
+    const char* name_;              ///< Name of the output, used in the report.
+    unsigned int mask_;             ///< Mask of the value in the export word.
+    byte shift_;                    ///< Shift of the value in the export word.
+    byte pin_;                      ///< Output pin that is read, or DcsBios::PIN_NC.
+    byte lastPinLevel_;             ///< Level of the pin at the last serviceLoop().
+    unsigned int value_;            ///< Last value seen in the export stream.
+    bool changed_;                  ///< True if the value changed in the frame being parsed.
+    bool waiting_;                  ///< True while the clock runs.
+    unsigned long frameEndMicros_;  ///< End of the frame that started the clock.
+    bool reportPending_;            ///< True while a report still has to be sent.
+    LatencyHistogram histogram_;    ///< Measured latencies.
+
+public:
+    /**
+     * @param name Name of the output, used in the report.
+     * @param address Export address of the value.
+     * @param mask Mask of the value.
+     * @param shift Shift of the value.
+     * @param pin Digital output pin driven by the value, or DcsBios::PIN_NC if the sketch calls outputChanged().
+     */
+    ActuatorLatencyProbe(const char* name, unsigned int address, unsigned int mask, byte shift, byte pin = DcsBios::PIN_NC)
+        : DcsBios::ExportStreamListener(address, address) {
+        name_ = name;
+        mask_ = mask;
+        shift_ = shift;
+        pin_ = pin;
+        lastPinLevel_ = LOW;
+        value_ = 0xFFFF;
+        changed_ = false;
+        waiting_ = false;
+        frameEndMicros_ = 0;
+        reportPending_ = false;
+    }
+
+    /**
+     * Notes that the value changed.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onDcsBiosWrite(unsigned int address, unsigned int value) {
+        unsigned int newValue = (value & mask_) >> shift_;
+        if (newValue != value_) {
+            value_ = newValue;
+            changed_ = true;
+        }
+    }
+
+    /**
+     * Starts the clock at the end of a frame that changed the value.
+     */
+    virtual void onConsistentData() {
+        if (changed_ == true) {
+            changed_ = false;
+            frameEndMicros_ = micros();
+            waiting_ = true;
+        }
+    }
+
+    /**
+     * Stops the clock. Call it right after updating an output that is not read from a pin.
+     */
+    void outputChanged() {
+        if (waiting_ == true) {
+            histogram_.add(micros() - frameEndMicros_);
+            waiting_ = false;
+        }
+    }
+
+    /**
+     * Stores report and clear requests from the host.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (value == 0) {
+            return;
+        }
+        if (address == OH_LATENCY_REPORT) {
+            reportPending_ = true;
+        } else if (address == OH_LATENCY_CLEAR) {
+            histogram_.clear();
+            waiting_ = false;
+        }
+    }
+
+    /**
+     * Reads the output pin, drops stale changes and sends a pending report.
+     */
+    virtual void serviceLoop() {
+        if (pin_ != DcsBios::PIN_NC) {
+            byte level = digitalRead(pin_);
+            if (level != lastPinLevel_) {
+                lastPinLevel_ = level;
+                outputChanged();
+            }
+        }
+        if (waiting_ == true && (micros() - frameEndMicros_) / 1000UL >= OH_ACTUATOR_TIMEOUT_MS) {
+            waiting_ = false;
+        }
+
+        if (reportPending_ == false) {
+            return;
+        }
+        ServiceReply reply;
+        reply.addText(name_);
+        reply.addNumber(histogram_.count());
+        reply.addNumber(histogram_.percentile(50));
+        reply.addNumber(histogram_.percentile(90));
+        reply.addNumber(histogram_.percentile(99));
+        reply.addNumber(histogram_.maximum());
+        if (reply.send("OH_ACTUATOR")) {
+            reportPending_ = false;
+        }
+    }
+
+    /**
+     * @return The measured latencies.
+     */
+    LatencyHistogram& histogram() {
+        return histogram_;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
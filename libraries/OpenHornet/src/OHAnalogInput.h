@@ -0,0 +1,66 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHAnalogInput.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Potentiometer that sends at most one command per time window while it is turned.
+ *
+ * DcsBios::Potentiometer reads its pin in every loop pass and sends whenever the value moved more than the
+ * hysteresis. Sweeping a volume knob or a dimmer then sends hundreds of commands per second, and DCS works through
+ * every one of them although only the last one counts. CoalescedPotentiometer reads the pin only once every
+ * OH_ANALOG_WINDOW_MS, so a sweep sends at most one command per window, always with the latest value. Switches and
+ * buttons are not affected and still send right away.
+ *
+ * Reading less often also means fewer samples for the smoothing filter. It uses a divisor of 2 instead of 5, so the
+ * value still settles within a few windows after the knob stops.
+ */
+
+#ifndef OH_ANALOG_INPUT_H
+#define OH_ANALOG_INPUT_H
+
+#include "DcsBios.h"
+
+#ifndef OH_ANALOG_WINDOW_MS
+#define OH_ANALOG_WINDOW_MS 25  ///< Time between two reads of a CoalescedPotentiometer, at most 40 commands per second.
+#endif
+
+namespace OpenHornet {
+
+/// DcsBios::Potentiometer that reads, and sends, at most once every OH_ANALOG_WINDOW_MS.
+typedef DcsBios::PotentiometerEWMA<OH_ANALOG_WINDOW_MS, 128, 2> CoalescedPotentiometer;
+
+}  // namespace OpenHornet
+
+#endif
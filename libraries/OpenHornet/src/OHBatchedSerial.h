@@ -0,0 +1,241 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHBatchedSerial.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief DCS-BIOS serial backend that sends all commands of one loop pass in one write.
+ *
+ * With DCSBIOS_DEFAULT_SERIAL every command is written to Serial on its own, in three writes (name, space and argument,
+ * newline). On boards with native USB (Pro Micro, S2 mini) each write can become its own USB packet. When many inputs
+ * change in the same loop pass (a resync after the link came back, the 20 position ILS knob turning through its
+ * positions, mission start) that is a lot of tiny packets.
+ *
+ * This backend collects the commands in a buffer of OH_TX_BATCH_LENGTH bytes, one full speed USB packet, and writes the
+ * buffer in one go:
+ * - at the end of DcsBios::loop(), after the inputs were polled;
+ * - at the start of DcsBios::loop(), for commands sent from elsewhere in loop() (service replies, custom logic);
+ * - before a command that does not fit any more.
+ *
+ * A command therefore waits at most one pass of loop(). Host tools can read the counters over the service channel
+ * by writing to OH_TX_STATS, the panel answers `OH_TX <packets> <commands> <bytes> <max wait in us> <ms>`, counted
+ * since the last request. Packets per second are packets * 1000 / ms.
+ *
+ * To use it, define OH_BATCHED_SERIAL instead of DCSBIOS_DEFAULT_SERIAL before including DcsBios.h, and include this
+ * file (or OHPanel.h) right after DcsBios.h.
+ */
+
+#ifndef OH_BATCHED_SERIAL_H
+#define OH_BATCHED_SERIAL_H
+
+#ifdef OH_BATCHED_SERIAL
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+
+#if defined(DCSBIOS_IRQ_SERIAL) || defined(DCSBIOS_DEFAULT_SERIAL) || defined(OH_ISR_EXPORT_PARSER)
+#error "Define only one of OH_BATCHED_SERIAL, OH_ISR_EXPORT_PARSER, DCSBIOS_IRQ_SERIAL and DCSBIOS_DEFAULT_SERIAL."
+#endif
+
+#ifndef OH_TX_BATCH_LENGTH
+#define OH_TX_BATCH_LENGTH 64  ///< Size of the batch buffer, one full speed USB packet.
+#endif
+
+#define OH_TX_STATS 0xFF16  ///< Host writes a non zero value to get the transmit counters.
+
+namespace OpenHornet {
+
+/**
+ * @class BatchedSerial
+ * @brief Collects commands and writes them to Serial in batches.
+ */
+class BatchedSerial : public ServiceHandler {
+private:
+    byte buffer_[OH_TX_BATCH_LENGTH];  ///< Commands waiting to be written.
+    byte length_;                      ///< Bytes in buffer_.
+    unsigned long firstMicros_;        ///< micros() when the oldest waiting command was added.
+    unsigned long packets_;            ///< Writes to Serial since the last report.
+    unsigned long commands_;           ///< Commands since the last report.
+    unsigned long bytes_;              ///< Bytes since the last report.
+    unsigned long maxWait_;            ///< Longest time a command waited in the buffer, in us.
+    unsigned long statsStart_;         ///< millis() of the last report.
+    bool reportPending_;               ///< True while a report still has to be sent.
+
+    /**
+     * Adds text to the buffer, writing it out whenever it fills up.
+     */
+    void add(const char* text) {
+        while (*text != '\0') {
+            if (length_ == OH_TX_BATCH_LENGTH) {
+                flush();
+            }
+            if (length_ == 0) {
+                firstMicros_ = micros();
+            }
+            buffer_[length_++] = *text++;
+        }
+    }
+
+public:
+    BatchedSerial() {
+        length_ = 0;
+        firstMicros_ = 0;
+        packets_ = 0;
+        commands_ = 0;
+        bytes_ = 0;
+        maxWait_ = 0;
+        statsStart_ = 0;
+        reportPending_ = false;
+    }
+
+    /**
+     * Adds one command line to the batch. A command that does not fit next to the waiting ones is sent in a new batch.
+     * @param msg Name of the control.
+     * @param arg Argument of the command.
+     */
+    void send(const char* msg, const char* arg) {
+        if (length_ + strlen(msg) + strlen(arg) + 2 > OH_TX_BATCH_LENGTH) {
+            flush();
+        }
+        add(msg);
+        add(" ");
+        add(arg);
+        add("\n");
+        commands_++;
+    }
+
+    /**
+     * Writes the waiting commands to Serial in one write.
+     */
+    void flush() {
+        if (length_ == 0) {
+            return;
+        }
+        Serial.write(buffer_, length_);
+        unsigned long wait = micros() - firstMicros_;
+        if (wait > maxWait_) {
+            maxWait_ = wait;
+        }
+        packets_++;
+        bytes_ += length_;
+        length_ = 0;
+    }
+
+    /**
+     * Stores the host's request for the counters.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (address == OH_TX_STATS && value != 0) {
+            reportPending_ = true;
+        }
+    }
+
+    /**
+     * Sends the counters when the host asked for them, and starts counting again.
+     */
+    virtual void serviceLoop() {
+        if (reportPending_ == false) {
+            return;
+        }
+        unsigned long now = millis();
+        ServiceReply reply;
+        reply.addNumber(packets_);
+        reply.addNumber(commands_);
+        reply.addNumber(bytes_);
+        reply.addNumber(maxWait_);
+        reply.addNumber(now - statsStart_);
+        if (reply.send("OH_TX")) {
+            reportPending_ = false;
+            packets_ = 0;
+            commands_ = 0;
+            bytes_ = 0;
+            maxWait_ = 0;
+            statsStart_ = now;
+        }
+    }
+};
+
+BatchedSerial batchedSerial;  ///< The one batch buffer of the sketch.
+
+}  // namespace OpenHornet
+
+namespace DcsBios {
+
+ProtocolParser parser;  ///< Parses the export stream, as in the other DCS-BIOS backends.
+
+/**
+ * Starts Serial at the DCS-BIOS baud rate.
+ */
+void setup() {
+    Serial.begin(250000);
+}
+
+/**
+ * Parses the export stream, polls the inputs and writes their commands out in one batch.
+ */
+void loop() {
+    OpenHornet::batchedSerial.flush();
+    while (Serial.available()) {
+        parser.processChar(Serial.read());
+    }
+    PollingInput::pollInputs();
+    ExportStreamListener::loopAll();
+    OpenHornet::batchedSerial.flush();
+}
+
+/**
+ * Adds a command line to the batch.
+ * @param msg Name of the control.
+ * @param arg Argument of the command.
+ */
+void sendDcsBiosMessage(const char* msg, const char* arg) {
+    OpenHornet::batchedSerial.send(msg, arg);
+    PollingInput::setMessageSentOrQueued();
+}
+
+/**
+ * Makes every input send its state again on the next poll, as the other DCS-BIOS backends do.
+ */
+void resetAllStates() {
+    PollingInput::resetAllStates();
+}
+
+}  // namespace DcsBios
+
+#endif
+
+#endif
@@ -0,0 +1,352 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHDebounceTuner.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Measures how long each input bounces and keeps the smallest safe debounce delay in EEPROM.
+ *
+ * The debounce delays in the sketches are guesses (10 ms for the DDI buttons, 100 ms for the INS and radar knobs),
+ * made long enough for the worst switch anyone has seen. A DebounceTuner replaces such a guess for one input or
+ * one group of inputs that share a delay. It starts with the guess as default, and the sketch asks delayMs() for
+ * the delay to use. The template parameter is the number of state bits the tuner times, the pins of a knob or
+ * the buttons of a group. Each bit costs 4 bytes of RAM, so size it to the input:
+ *
+ *     OpenHornet::DebounceTuner<4> radarDebounce("RADAR_SW", 1, 100, radarSwPins, 4);
+ *
+ * A group shares one delay, the longest any of its inputs needs. Give an input its own tuner and slot when it
+ * bounces much longer than the rest of its group.
+ *
+ * ### Calibration:
+ * The host writes OH_DEBOUNCE_START to OH_DEBOUNCE_CALIBRATE on the service channel, then the builder flips every
+ * switch of the panel a few dozen times. Each tuner watches every bit of its raw input state on its own and times
+ * every bounce burst, from the first edge to the last edge before the bit stays quiet for the settle window. The
+ * settle window is OH_BOUNCE_SETTLE_MS, or the default delay if that is shorter, so two real presses in a row are
+ * not merged into one burst. A burst only counts if the bit ends up in a different state than it started in, a
+ * glitch that comes back is noise and no flip. A clean switch gives 0.
+ * The input is read once per loop pass, the same rate the debounce logic sees it at, so bounces shorter than a
+ * loop pass are not seen but do not matter either.
+ *
+ * Writing OH_DEBOUNCE_STORE ends the calibration. Every tuner with at least OH_DEBOUNCE_MIN_SAMPLES bursts sets
+ * its delay to the longest burst plus OH_DEBOUNCE_MARGIN_PERCENT, at least OH_DEBOUNCE_MIN_MS, and keeps it in
+ * EEPROM. Then every tuner replies once:
+ *
+ *     OH_DEBOUNCE <name> <count> <p50> <p99> <max> <delay>
+ *
+ * with the burst times in microseconds and the delay in ms. OH_DEBOUNCE_REPORT only replies, OH_DEBOUNCE_FORGET
+ * erases the stored delays and goes back to the defaults.
+ *
+ * Each tuner owns one EEPROM word, at OH_DEBOUNCE_EEPROM_BASE + 2 * slot. Slots must be unique within a sketch.
+ * An erased word (0xFFFF) means the default is used. EEPROM is only used on AVR boards, other boards measure and
+ * report but always run with the defaults.
+ *
+ * @note Inputs that copy their delay when they are created (DcsBios::Switch2Pos, SwitchMultiPosDebounce) pick up
+ * a stored delay after the next reset. Sketches that ask delayMs() in every loop pass use it right away.
+ */
+
+#ifndef OH_DEBOUNCE_TUNER_H
+#define OH_DEBOUNCE_TUNER_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHLatencyHistogram.h"
+
+#ifdef __AVR__
+#include <avr/eeprom.h>
+#endif
+
+#define OH_DEBOUNCE_CALIBRATE 0xFF18  ///< Host writes one of the OH_DEBOUNCE_ commands below to the service channel.
+#define OH_DEBOUNCE_START 1           ///< Clears the measurements and starts a calibration.
+#define OH_DEBOUNCE_STORE 2           ///< Ends the calibration, stores the new delays and reports them.
+#define OH_DEBOUNCE_REPORT 3          ///< Reports the measurements and delays.
+#define OH_DEBOUNCE_FORGET 4          ///< Erases the stored delays, the defaults are used again.
+
+#ifndef OH_DEBOUNCE_EEPROM_BASE
+#define OH_DEBOUNCE_EEPROM_BASE 0  ///< EEPROM address of slot 0.
+#endif
+
+#ifndef OH_BOUNCE_SETTLE_MS
+#define OH_BOUNCE_SETTLE_MS 5  ///< A burst ends once its bit did not change for this long, or for the default delay if shorter.
+#endif
+
+#define OH_BOUNCE_MAX_US 60000U  ///< Bursts are cut off at this length, the time stamps are 16 bit.
+
+#ifndef OH_DEBOUNCE_MIN_SAMPLES
+#define OH_DEBOUNCE_MIN_SAMPLES 20  ///< Fewer bursts than this are not trusted, the delay stays as it was.
+#endif
+
+#ifndef OH_DEBOUNCE_MARGIN_PERCENT
+#define OH_DEBOUNCE_MARGIN_PERCENT 50  ///< Safety margin added to the longest burst.
+#endif
+
+#ifndef OH_DEBOUNCE_MIN_MS
+#define OH_DEBOUNCE_MIN_MS 2  ///< Shortest delay that is ever stored.
+#endif
+
+#define OH_DEBOUNCE_MAX_MS 1000  ///< Longest delay that is ever stored.
+
+namespace OpenHornet {
+
+/**
+ * @class DebounceTuner
+ * @brief Measures the bounce of one input and provides its debounce delay.
+ * @tparam numberOfBits Number of state bits timed, up to 32.
+ */
+template <byte numberOfBits>
+class DebounceTuner : public ServiceHandler {
+    static_assert(numberOfBits >= 1 && numberOfBits <= 32, "A DebounceTuner times 1 to 32 bits.");
+
+private:
+    const char* name_;             ///< Name of the input, used in the report.
+    byte slot_;                    ///< EEPROM slot of the stored delay.
+    unsigned int defaultMs_;       ///< Delay used while nothing is stored.
+    unsigned int delayMs_;         ///< Delay in use.
+    const byte* pins_;             ///< Pins read while calibrating, NULL if the sketch calls sample().
+    byte numberOfPins_;            ///< Number of entries in pins_.
+    bool calibrating_;             ///< True while a calibration runs.
+    bool primed_;                  ///< True once the first state of the calibration was seen.
+    unsigned long lastState_;      ///< Raw input state seen last.
+    unsigned long bouncing_;       ///< One bit per input bit that is in a burst.
+    unsigned long startState_;     ///< State of each input bit before its burst.
+    unsigned int burstStart_[numberOfBits];  ///< Time of the first edge of each bit's burst, low 16 bits of micros().
+    unsigned int lastEdge_[numberOfBits];    ///< Time of the latest edge of each bit's burst, low 16 bits of micros().
+    byte pendingCommand_;          ///< Host command still to be carried out, 0 for none.
+    bool reportPending_;           ///< True while a report still has to be sent.
+    LatencyHistogram histogram_;   ///< Measured burst times.
+
+    /**
+     * @return The EEPROM word of this tuner's slot.
+     */
+    uint16_t* eepromWord() {
+        return (uint16_t*)(OH_DEBOUNCE_EEPROM_BASE + 2 * slot_);
+    }
+
+    /**
+     * Reads the stored delay, or uses the default if there is none.
+     */
+    void load() {
+        delayMs_ = defaultMs_;
+#ifdef __AVR__
+        uint16_t stored = eeprom_read_word(eepromWord());
+        if (stored != 0xFFFF && stored != 0) {
+            delayMs_ = stored;
+        }
+#endif
+    }
+
+    /**
+     * Keeps a delay in EEPROM, 0xFFFF erases it.
+     * @param value The delay in ms.
+     */
+    void store(uint16_t value) {
+#ifdef __AVR__
+        eeprom_update_word(eepromWord(), value);
+#endif
+    }
+
+    /**
+     * Works out the new delay from the bursts measured and stores it.
+     */
+    void finishCalibration() {
+        calibrating_ = false;
+        bouncing_ = 0;
+        if (histogram_.count() < OH_DEBOUNCE_MIN_SAMPLES) {
+            return;
+        }
+        unsigned long safeMs = (histogram_.maximum() * (100 + OH_DEBOUNCE_MARGIN_PERCENT) / 100 + 999) / 1000;
+        delayMs_ = constrain(safeMs, (unsigned long)OH_DEBOUNCE_MIN_MS, (unsigned long)OH_DEBOUNCE_MAX_MS);
+        store(delayMs_);
+    }
+
+    /**
+     * @return The raw state of the pins, one bit per pin.
+     */
+    unsigned long readPins() {
+        unsigned long state = 0;
+        for (byte i = 0; i < numberOfPins_; i++) {
+            if (pins_[i] != DcsBios::PIN_NC && digitalRead(pins_[i]) == HIGH) {
+                state |= 1UL << i;
+            }
+        }
+        return state;
+    }
+
+public:
+    /**
+     * Creates a tuner that the sketch feeds through sample(), for inputs that are not read from pins.
+     * @param name Name of the input, used in the report.
+     * @param slot EEPROM slot of the stored delay, unique within the sketch.
+     * @param defaultMs Delay used while nothing is stored, in ms.
+     */
+    DebounceTuner(const char* name, byte slot, unsigned int defaultMs) {
+        name_ = name;
+        slot_ = slot;
+        defaultMs_ = defaultMs;
+        pins_ = NULL;
+        numberOfPins_ = 0;
+        calibrating_ = false;
+        primed_ = false;
+        lastState_ = 0;
+        bouncing_ = 0;
+        startState_ = 0;
+        pendingCommand_ = 0;
+        reportPending_ = false;
+        load();
+    }
+
+    /**
+     * Creates a tuner that reads the pins of a switch itself while calibrating.
+     * @param name Name of the input, used in the report.
+     * @param slot EEPROM slot of the stored delay, unique within the sketch.
+     * @param defaultMs Delay used while nothing is stored, in ms.
+     * @param pins Pins of the switch, DcsBios::PIN_NC entries are skipped.
+     * @param numberOfPins Number of entries in pins, up to numberOfBits.
+     */
+    DebounceTuner(const char* name, byte slot, unsigned int defaultMs, const byte* pins, byte numberOfPins)
+        : DebounceTuner(name, slot, defaultMs) {
+        pins_ = pins;
+        numberOfPins_ = (numberOfPins > numberOfBits) ? numberOfBits : numberOfPins;
+    }
+
+    /**
+     * @return The debounce delay to use, in ms.
+     */
+    unsigned int delayMs() {
+        return delayMs_;
+    }
+
+    /**
+     * Hands the tuner the raw state of its input. Cheap when no calibration runs, call it once per loop pass.
+     * @param state The raw input state, one bit per button or pin. Each of the low numberOfBits bits is timed on
+     * its own, the others are ignored.
+     */
+    void sample(unsigned long state) {
+        if (calibrating_ == false) {
+            return;
+        }
+        if (numberOfBits < 32) {
+            state &= (1UL << (numberOfBits & 31)) - 1;  // Only the bits this tuner has room for.
+        }
+        if (primed_ == false) {
+            primed_ = true;  // The state before the first flip is not an edge.
+            lastState_ = state;
+            return;
+        }
+        unsigned long changed = state ^ lastState_;
+        if ((changed | bouncing_) == 0) {
+            return;
+        }
+        unsigned int now = micros();
+        unsigned int settleUs = min(defaultMs_, (unsigned int)OH_BOUNCE_SETTLE_MS) * 1000U;
+        for (byte i = 0; i < numberOfBits; i++) {
+            unsigned long bit = 1UL << i;
+            if (changed & bit) {
+                if ((bouncing_ & bit) == 0) {
+                    bouncing_ |= bit;
+                    startState_ = (startState_ & ~bit) | (lastState_ & bit);
+                    burstStart_[i] = now;
+                }
+                lastEdge_[i] = now;
+            } else if (bouncing_ & bit) {
+                if ((unsigned int)(now - lastEdge_[i]) >= settleUs || (unsigned int)(now - burstStart_[i]) >= OH_BOUNCE_MAX_US) {
+                    bouncing_ &= ~bit;
+                    if ((state ^ startState_) & bit) {
+                        histogram_.add((unsigned int)(lastEdge_[i] - burstStart_[i]));
+                    }
+                }
+            }
+        }
+        lastState_ = state;
+    }
+
+    /**
+     * Stores calibration commands from the host.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (address == OH_DEBOUNCE_CALIBRATE && value != 0) {
+            pendingCommand_ = value;
+        }
+    }
+
+    /**
+     * Carries out a pending command, reads the pins while calibrating and sends a pending report.
+     */
+    virtual void serviceLoop() {
+        switch (pendingCommand_) {
+            case OH_DEBOUNCE_START:
+                histogram_.clear();
+                bouncing_ = 0;
+                primed_ = false;
+                calibrating_ = true;
+                break;
+            case OH_DEBOUNCE_STORE:
+                finishCalibration();
+                reportPending_ = true;
+                break;
+            case OH_DEBOUNCE_REPORT:
+                reportPending_ = true;
+                break;
+            case OH_DEBOUNCE_FORGET:
+                store(0xFFFF);
+                delayMs_ = defaultMs_;
+                reportPending_ = true;
+                break;
+        }
+        pendingCommand_ = 0;
+
+        if (pins_ != NULL) {
+            sample(readPins());
+        }
+        if (reportPending_ == false) {
+            return;
+        }
+        ServiceReply reply;
+        reply.addText(name_);
+        reply.addNumber(histogram_.count());
+        reply.addNumber(histogram_.percentile(50));
+        reply.addNumber(histogram_.percentile(99));
+        reply.addNumber(histogram_.maximum());
+        reply.addNumber(delayMs_);
+        if (reply.send("OH_DEBOUNCE")) {
+            reportPending_ = false;
+        }
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
@@ -0,0 +1,327 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHDimmer.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Lets backlights follow a dimmer knob right away instead of waiting for the sim.
+ *
+ * Turning the INST PNL dimmer on 5A6A1 sends a command to DCS, DCS changes INSTR_INT_LT (0x7560), and only when that
+ * comes back in the export stream does 1A3 change the DDI backlight. The round trip is easy to see.
+ * With the dimmer relayed over the service channel, the backlight predicts the new level instead:
+ *
+ * -# A DimmerPublisher on the dimmer's panel reads the knob once every OH_ANALOG_WINDOW_MS, smooths it like a
+ *    CoalescedPotentiometer and sends `OH_DIMMER <channel> <value>` when it moved more than OH_DIMMER_HYSTERESIS,
+ *    with the value scaled to 0 - 65535 like the DCS-BIOS command. ADC noise must not get through, every value sent
+ *    holds the sim's value back for another OH_DIMMER_HOLD_MS.
+ * -# The host relays the value to every panel, as a write to OH_DIMMER_FIRST_ADDRESS + 2 * channel.
+ * -# A PredictedDimmer on an output's panel sets the output to the relayed value right away.
+ * -# OH_DIMMER_HOLD_MS after the last relayed value, the export value is trusted again. The sim has caught up
+ *    by then, and the output ramps over OH_DIMMER_RAMP_MS to the export value if the prediction was off (lights
+ *    without power, day/night mode, light test).
+ *
+ * Without a host that relays, nothing changes: the PredictedDimmer follows the export value right away, like a
+ * DcsBios::IntegerBuffer. The relayed values are not limited to one panel, any number of outputs on any panel can
+ * follow the same channel.
+ *
+ * To time the output with an ActuatorLatencyProbe, hand the probe to the PredictedDimmer instead of calling
+ * outputChanged() from the output function. The PredictedDimmer only stops the probe's clock when it applies an
+ * export value as it comes, not for predictions and ramp steps, which are not caused by the export change. It
+ * applies export values from serviceLoop(), after DcsBios::loop() ended the frame and started the probe's clock, so
+ * the order of the two listeners does not matter.
+ */
+
+#ifndef OH_DIMMER_H
+#define OH_DIMMER_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHAnalogInput.h"
+#include "OHActuatorLatency.h"
+
+#define OH_DIMMER_FIRST_ADDRESS 0xFF1E  ///< Host writes the relayed value of channel n to OH_DIMMER_FIRST_ADDRESS + 2 * n.
+#define OH_DIMMER_CHANNELS 4            ///< Number of dimmer channels.
+
+#define OH_DIMMER_INSTRUMENTS 0  ///< INST_PNL_DIMMER, the sim turns it into INSTR_INT_LT.
+#define OH_DIMMER_CONSOLES 1     ///< CONSOLES_DIMMER, the sim turns it into CONSOLE_INT_LT.
+#define OH_DIMMER_FLOOD 2        ///< FLOOD_DIMMER.
+#define OH_DIMMER_CHART 3        ///< CHART_DIMMER.
+
+#ifndef OH_DIMMER_HYSTERESIS
+#define OH_DIMMER_HYSTERESIS 384  ///< Smallest change a DimmerPublisher sends, 6 steps of the 10 bit ADC.
+#endif
+
+#define OH_DIMMER_FILTER_DIVISOR 2  ///< Smoothing of a DimmerPublisher, the same as CoalescedPotentiometer.
+#define OH_DIMMER_FILTER_SCALE 16   ///< The smoothed reading keeps 4 bits below the ADC's resolution.
+
+#ifndef OH_DIMMER_HOLD_MS
+#define OH_DIMMER_HOLD_MS 500  ///< Export values are ignored for this long after a relayed value.
+#endif
+
+#ifndef OH_DIMMER_RAMP_MS
+#define OH_DIMMER_RAMP_MS 200  ///< Time to move from a wrong prediction to the export value.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class DimmerPublisher
+ * @brief Sends the position of a dimmer knob to the host, for the host to relay.
+ */
+class DimmerPublisher : public ServiceHandler {
+private:
+    byte channel_;                ///< Dimmer channel.
+    byte pin_;                    ///< Analog pin of the knob.
+    unsigned int filtered_;       ///< Smoothed reading, in 1/OH_DIMMER_FILTER_SCALE ADC steps.
+    bool primed_;                 ///< True once filtered_ holds a reading.
+    unsigned int lastValue_;      ///< Value sent last.
+    unsigned int value_;          ///< Value to send.
+    bool pending_;                ///< True while value_ still has to be sent.
+    unsigned long lastReadMs_;    ///< millis() of the last read.
+
+public:
+    /**
+     * @param channel Dimmer channel, one of the OH_DIMMER_ channels.
+     * @param pin Analog pin of the knob, the same as its DcsBios::Potentiometer.
+     */
+    DimmerPublisher(byte channel, byte pin) {
+        channel_ = channel;
+        pin_ = pin;
+        filtered_ = 0;
+        primed_ = false;
+        lastValue_ = 0;
+        value_ = 0;
+        pending_ = false;  // Nothing to send before the first reading.
+        lastReadMs_ = 0;
+    }
+
+    /**
+     * Reads the knob once per window, smooths it and sends its value when it moved.
+     * The first reading is taken right away and always sent, so the host learns where the knob is at the start.
+     */
+    virtual void serviceLoop() {
+        unsigned long now = millis();
+        if (primed_ == false || now - lastReadMs_ >= OH_ANALOG_WINDOW_MS) {
+            lastReadMs_ = now;
+            unsigned int reading = analogRead(pin_);
+            int target = reading * OH_DIMMER_FILTER_SCALE;
+            bool first = primed_ == false;
+            if (first == true || reading == 0 || reading == 1023) {
+                filtered_ = target;  // The stops are exact, the filter would only creep towards them.
+                primed_ = true;
+            } else {
+                filtered_ += (target - (int)filtered_) / OH_DIMMER_FILTER_DIVISOR;
+            }
+            unsigned int value = map(filtered_, 0, 1023L * OH_DIMMER_FILTER_SCALE, 0, 65535);
+            long change = (long)value - (long)lastValue_;
+            // The ends always go out, so the knob's stops reach full off and full on.
+            bool atEnd = (value == 0 || value == 65535) && change != 0;
+            if (first == true || change > OH_DIMMER_HYSTERESIS || change < -OH_DIMMER_HYSTERESIS || atEnd) {
+                value_ = value;
+                pending_ = true;
+            }
+        }
+        if (pending_ == false) {
+            return;
+        }
+        ServiceReply reply;
+        reply.addNumber(channel_);
+        reply.addNumber(value_);
+        if (reply.send("OH_DIMMER")) {
+            lastValue_ = value_;
+            pending_ = false;
+        }
+    }
+};
+
+/**
+ * @class PredictedDimmer
+ * @brief Drives an output from an export value, and from the relayed dimmer before the export value catches up.
+ */
+class PredictedDimmer : public ServiceHandler, public DcsBios::ExportStreamListener {
+private:
+    byte channel_;                         ///< Dimmer channel that predicts the export value.
+    unsigned int mask_;                    ///< Mask of the export value.
+    byte shift_;                           ///< Shift of the export value.
+    void (*output_)(unsigned int value);   ///< Sets the output.
+    unsigned int exportValue_;             ///< Latest export value.
+    bool exportChanged_;                   ///< True if exportValue_ was not acted on yet.
+    unsigned int predicted_;               ///< Latest relayed value.
+    bool predictionPending_;               ///< True if predicted_ was not acted on yet.
+    bool predicting_;                      ///< True while export values are ignored.
+    unsigned long predictionMs_;           ///< millis() of the latest relayed value.
+    unsigned int current_;                 ///< Value the output shows.
+    bool ramping_;                         ///< True while moving to the export value.
+    unsigned int rampFrom_;                ///< Value at the start of the ramp.
+    unsigned long rampStartMs_;            ///< millis() at the start of the ramp.
+    ActuatorLatencyProbe* probe_;          ///< Probe stopped when an export value is applied, NULL for none.
+
+    /**
+     * Sets the output if the value changed.
+     * @param value The new value.
+     */
+    void setOutput(unsigned int value) {
+        if (value != current_) {
+            current_ = value;
+            output_(value);
+        }
+    }
+
+public:
+    /**
+     * @param channel Dimmer channel that predicts the export value, one of the OH_DIMMER_ channels.
+     * @param address Export address of the value.
+     * @param mask Mask of the value.
+     * @param shift Shift of the value.
+     * @param output Sets the output, called with the value like a DcsBios::IntegerBuffer callback.
+     */
+    PredictedDimmer(byte channel, unsigned int address, unsigned int mask, byte shift, void (*output)(unsigned int value))
+        : DcsBios::ExportStreamListener(address, address) {
+        channel_ = channel;
+        mask_ = mask;
+        shift_ = shift;
+        output_ = output;
+        exportValue_ = 0;
+        exportChanged_ = false;
+        predicted_ = 0;
+        predictionPending_ = false;
+        predicting_ = false;
+        predictionMs_ = 0;
+        current_ = 0;
+        ramping_ = false;
+        rampFrom_ = 0;
+        rampStartMs_ = 0;
+        probe_ = NULL;
+    }
+
+    /**
+     * @param channel Dimmer channel that predicts the export value, one of the OH_DIMMER_ channels.
+     * @param address Export address of the value.
+     * @param mask Mask of the value.
+     * @param shift Shift of the value.
+     * @param output Sets the output, called with the value like a DcsBios::IntegerBuffer callback.
+     * @param probe Probe that times the output, listening to the same export value.
+     */
+    PredictedDimmer(byte channel, unsigned int address, unsigned int mask, byte shift, void (*output)(unsigned int value),
+                    ActuatorLatencyProbe& probe)
+        : PredictedDimmer(channel, address, mask, shift, output) {
+        probe_ = &probe;
+    }
+
+    /**
+     * Stores the export value.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onDcsBiosWrite(unsigned int address, unsigned int value) {
+        unsigned int newValue = (value & mask_) >> shift_;
+        if (newValue != exportValue_) {
+            exportValue_ = newValue;
+            exportChanged_ = true;
+        }
+    }
+
+    /**
+     * Stores a relayed value of the channel.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (address == OH_DIMMER_FIRST_ADDRESS + 2 * channel_) {
+            predicted_ = value;
+            predictionPending_ = true;
+        }
+    }
+
+    /**
+     * Applies relayed values right away and export values once no prediction is held, ramping after a prediction.
+     */
+    virtual void serviceLoop() {
+        unsigned long now = millis();
+
+        if (predictionPending_ == true) {
+            predictionPending_ = false;
+            predicting_ = true;
+            predictionMs_ = now;
+            ramping_ = false;
+            setOutput(predicted_);
+            return;
+        }
+
+        if (predicting_ == true) {
+            if (now - predictionMs_ < OH_DIMMER_HOLD_MS) {
+                return;
+            }
+            predicting_ = false;
+            exportChanged_ = false;
+            ramping_ = true;
+            rampFrom_ = current_;
+            rampStartMs_ = now;
+        } else if (exportChanged_ == true) {
+            exportChanged_ = false;
+            if (ramping_ == false) {
+                bool moves = exportValue_ != current_;
+                setOutput(exportValue_);
+                if (moves == true && probe_ != NULL) {
+                    probe_->outputChanged();
+                }
+                return;
+            }
+            // Keep ramping, towards the newer value.
+        }
+
+        if (ramping_ == true) {
+            unsigned long elapsed = now - rampStartMs_;
+            if (elapsed >= OH_DIMMER_RAMP_MS) {
+                ramping_ = false;
+                setOutput(exportValue_);
+            } else {
+                long step = ((long)exportValue_ - (long)rampFrom_) * (long)elapsed / OH_DIMMER_RAMP_MS;
+                setOutput(rampFrom_ + step);
+            }
+        }
+    }
+
+    /**
+     * @return The value the output shows.
+     */
+    unsigned int value() {
+        return current_;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
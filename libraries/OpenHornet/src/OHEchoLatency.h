@@ -0,0 +1,232 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHEchoLatency.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Measures how long the sim takes to echo a switch command back in the export stream.
+ *
+ * When a switch is thrown, its DCS-BIOS command goes to the host, DCS moves the switch in the cockpit, and the new
+ * position comes back in the export stream (APU_CONTROL_SW at 0x74c2, LAUNCH_BAR_SW at 0x7480). An EchoLatencyProbe
+ * watches the same pin as the switch and the address of its export value, and puts the time between the two into
+ * a LatencyHistogram. Comparing these numbers with the scan and debounce times of the panel shows whether lag
+ * comes from the pit hardware or from the host and the sim.
+ *
+ * The probe debounces the pin like DcsBios::Switch2Pos, so it starts timing in the same loop pass in which the
+ * switch sends its command. An echo that does not arrive within OH_ECHO_TIMEOUT_MS counts as lost.
+ *
+ * A pin change to the position the export stream already shows is not timed. That is the switch following the sim,
+ * like a magnet held switch (APU, engine crank) that drops back when the sim releases its magnet.
+ *
+ * Host tools read the results over the service channel. A write to OH_LATENCY_REPORT makes every probe reply once:
+ *
+ *     OH_ECHO <msg> <count> <lost> <p50> <p90> <p99> <max>
+ *
+ * with all times in microseconds. A write to OH_LATENCY_CLEAR starts a new measurement.
+ */
+
+#ifndef OH_ECHO_LATENCY_H
+#define OH_ECHO_LATENCY_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHLatencyHistogram.h"
+
+#ifndef OH_ECHO_TIMEOUT_MS
+#define OH_ECHO_TIMEOUT_MS 2000  ///< An echo later than this counts as lost.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class EchoLatencyProbe
+ * @brief Times the export echo of one two position switch.
+ */
+class EchoLatencyProbe : public ServiceHandler, public DcsBios::ExportStreamListener {
+private:
+    const char* msg_;                    ///< Name of the switch's DCS-BIOS command, used in the report.
+    char pin_;                           ///< Arduino pin of the switch.
+    bool reverse_;                       ///< Same as the reverse flag of the switch.
+    unsigned long debounceDelay_;        ///< Same as the debounce delay of the switch, in ms.
+    unsigned int mask_;                  ///< Mask of the switch's value in the export word.
+    byte shift_;                         ///< Shift of the switch's value in the export word.
+    char steadyState_;                   ///< Pin state while debouncing.
+    char lastState_;                     ///< Pin state that was last "sent".
+    unsigned long lastDebounceTime_;     ///< Time of the last pin change, in ms.
+    bool waiting_;                       ///< True while an echo is expected.
+    unsigned int expectedValue_;         ///< Export value the echo must have.
+    unsigned int exportValue_;           ///< Switch's value in the export stream seen last.
+    bool exportKnown_;                   ///< True once exportValue_ was received.
+    unsigned long sentMicros_;           ///< Time the command was sent.
+    unsigned int lost_;                  ///< Number of echoes that never came.
+    bool reportPending_;                 ///< True while a report still has to be sent.
+    LatencyHistogram histogram_;         ///< Measured latencies.
+
+    /**
+     * Debounces the pin like DcsBios::Switch2Pos and starts timing when the switch sends.
+     */
+    void pollPin() {
+        char state = digitalRead(pin_);
+        if (reverse_) {
+            state = !state;
+        }
+        unsigned long now = millis();
+        if (state != steadyState_) {
+            lastDebounceTime_ = now;
+            steadyState_ = state;
+        }
+        if ((now - lastDebounceTime_) >= debounceDelay_ && steadyState_ != lastState_) {
+            lastState_ = steadyState_;
+            if (waiting_ == true) {
+                lost_++;  // Thrown again before the echo came back.
+            }
+            expectedValue_ = (steadyState_ == HIGH) ? 0 : 1;
+            // A switch that follows the sim has nothing to echo.
+            waiting_ = exportKnown_ == false || exportValue_ != expectedValue_;
+            sentMicros_ = micros();
+        }
+        if (waiting_ == true && (micros() - sentMicros_) / 1000UL >= OH_ECHO_TIMEOUT_MS) {
+            waiting_ = false;
+            lost_++;
+        }
+    }
+
+public:
+    /**
+     * Creates a probe for a DcsBios::Switch2Pos.
+     * @param msg Command name of the switch.
+     * @param pin Arduino pin of the switch.
+     * @param address Export address of the switch's value.
+     * @param mask Mask of the switch's value.
+     * @param shift Shift of the switch's value.
+     * @param reverse Same as the reverse flag of the switch.
+     * @param debounceDelay Same as the debounce delay of the switch, in ms.
+     */
+    EchoLatencyProbe(const char* msg, char pin, unsigned int address, unsigned int mask, byte shift, bool reverse = false, unsigned long debounceDelay = 50)
+        : DcsBios::ExportStreamListener(address, address) {
+        msg_ = msg;
+        pin_ = pin;
+        reverse_ = reverse;
+        debounceDelay_ = debounceDelay;
+        mask_ = mask;
+        shift_ = shift;
+        lastDebounceTime_ = 0;
+        waiting_ = false;
+        expectedValue_ = 0;
+        exportValue_ = 0;
+        exportKnown_ = false;
+        sentMicros_ = 0;
+        lost_ = 0;
+        reportPending_ = false;
+        // The switch sends its start position without a throw, do not time that one.
+        pinMode(pin_, INPUT_PULLUP);
+        steadyState_ = digitalRead(pin_);
+        if (reverse_) {
+            steadyState_ = !steadyState_;
+        }
+        lastState_ = steadyState_;
+    }
+
+    /**
+     * Notes the switch's value and stops the clock when it changes to the expected one.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onDcsBiosWrite(unsigned int address, unsigned int value) {
+        exportValue_ = (value & mask_) >> shift_;
+        exportKnown_ = true;
+        if (waiting_ == true && exportValue_ == expectedValue_) {
+            histogram_.add(micros() - sentMicros_);
+            waiting_ = false;
+        }
+    }
+
+    /**
+     * Stores report and clear requests from the host.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (value == 0) {
+            return;
+        }
+        if (address == OH_LATENCY_REPORT) {
+            reportPending_ = true;
+        } else if (address == OH_LATENCY_CLEAR) {
+            histogram_.clear();
+            lost_ = 0;
+            waiting_ = false;
+        }
+    }
+
+    /**
+     * Polls the pin and sends a pending report.
+     */
+    virtual void serviceLoop() {
+        pollPin();
+        if (reportPending_ == false) {
+            return;
+        }
+        ServiceReply reply;
+        reply.addText(msg_);
+        reply.addNumber(histogram_.count());
+        reply.addNumber(lost_);
+        reply.addNumber(histogram_.percentile(50));
+        reply.addNumber(histogram_.percentile(90));
+        reply.addNumber(histogram_.percentile(99));
+        reply.addNumber(histogram_.maximum());
+        if (reply.send("OH_ECHO")) {
+            reportPending_ = false;
+        }
+    }
+
+    /**
+     * @return The measured latencies.
+     */
+    LatencyHistogram& histogram() {
+        return histogram_;
+    }
+
+    /**
+     * @return The number of echoes that never came.
+     */
+    unsigned int lost() {
+        return lost_;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
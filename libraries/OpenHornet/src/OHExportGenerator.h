@@ -0,0 +1,396 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHExportGenerator.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Generates a DCS-BIOS export stream without DCS, to load test panels.
+ *
+ * The generator writes frames in the export stream format: the sync bytes 0x55 0x55 0x55 0x55, one block
+ * (address, length, data) per changed 16 bit word, and the frame counter at 0xFFFE last. Like DCS-BIOS, the
+ * frame counter is an 8 bit update counter in the low byte, the high byte (skipped frames) stays 0. The bytes go to a sink
+ * function, which can write them to a UART wired to the panel under test, or hand them straight to
+ * DcsBios::parser to load the sketch it runs in.
+ *
+ * What a frame contains is set up with:
+ * - **A scenario:** a scripted list of value changes, see ExportScenarioStep. OH_SCENARIO_COLD_START,
+ *   OH_SCENARIO_CAT_LAUNCH and OH_SCENARIO_TRAP drive the WoW, RPM, APU, launch bar, hook and canopy addresses
+ *   that the panels listen to.
+ * - **Change density:** a number of extra words per frame, with random values at random addresses of an address
+ *   range. The range must be one that no panel listens to, random values there would move switches and lights
+ *   that the sim never moved. The default, OH_NOISE_FIRST_ADDRESS to OH_NOISE_LAST_ADDRESS, lies above the
+ *   F/A-18C's export data and below the service channel. The panel still parses every noise word.
+ * - **String churn:** the IFEI fuel display changes in every frame, like it does while fuel is burned.
+ */
+
+#ifndef OH_EXPORT_GENERATOR_H
+#define OH_EXPORT_GENERATOR_H
+
+#include "Arduino.h"
+
+#ifndef OH_GENERATOR_WORDS
+#define OH_GENERATOR_WORDS 16  ///< Number of export words the generator keeps values for.
+#endif
+
+#define OH_FUEL_DOWN_ADDRESS 0x748a      ///< IFEI_FUEL_DOWN, the string changed by string churn.
+#define OH_FUEL_DOWN_LENGTH 6            ///< Length of IFEI_FUEL_DOWN.
+#define OH_FRAME_COUNTER_ADDRESS 0xFFFE  ///< DCS-BIOS writes its frame counter here at the end of every frame.
+
+#ifndef OH_NOISE_FIRST_ADDRESS
+#define OH_NOISE_FIRST_ADDRESS 0x8000  ///< First address of the random words, no panel listens to it.
+#endif
+
+#ifndef OH_NOISE_LAST_ADDRESS
+#define OH_NOISE_LAST_ADDRESS 0x81FE  ///< Last address of the random words.
+#endif
+
+namespace OpenHornet {
+
+typedef void (*ExportByteSink)(byte);  ///< Receives the generated stream one byte at a time.
+
+/**
+ * @brief One step of a scenario.
+ *
+ * Integer steps set the bits of mask at address to value, like DcsBios::IntegerBuffer reads them.
+ * A step with a mask of 0 writes value as a right aligned three character string, which is how the IFEI
+ * shows the engine RPM.
+ */
+struct ExportScenarioStep {
+    unsigned long timeMs;  ///< Time of the step after the scenario starts.
+    unsigned int address;  ///< Export address.
+    unsigned int mask;     ///< Mask of the value, 0 for a three character string.
+    byte shift;            ///< Shift of the value.
+    unsigned int value;    ///< New value.
+};
+
+/// Ground cold start: WoW, canopy closing, APU start, both engines spooling up to idle.
+const ExportScenarioStep OH_SCENARIO_COLD_START[] PROGMEM = {
+    { 0, 0x74d8, 0x0100, 8, 1 },       // EXT_WOW_LEFT
+    { 0, 0x74d6, 0x4000, 14, 1 },      // EXT_WOW_NOSE
+    { 0, 0x74d6, 0x8000, 15, 1 },      // EXT_WOW_RIGHT
+    { 0, 0x7552, 0xffff, 0, 65535 },   // CANOPY_POS open
+    { 0, 0x749e, 0, 0, 0 },            // IFEI_RPM_L
+    { 0, 0x74a2, 0, 0, 0 },            // IFEI_RPM_R
+    { 1000, 0x74c2, 0x0100, 8, 1 },    // APU_CONTROL_SW on
+    { 4000, 0x74c2, 0x0800, 11, 1 },   // APU_READY_LT
+    { 5000, 0x74c2, 0x0600, 9, 2 },    // ENGINE_CRANK_SW right
+    { 6000, 0x74a2, 0, 0, 15 },
+    { 8000, 0x74a2, 0, 0, 40 },
+    { 10000, 0x74a2, 0, 0, 63 },
+    { 11000, 0x74c2, 0x0600, 9, 1 },   // ENGINE_CRANK_SW off
+    { 12000, 0x74c2, 0x0600, 9, 0 },   // ENGINE_CRANK_SW left
+    { 13000, 0x749e, 0, 0, 15 },
+    { 15000, 0x749e, 0, 0, 40 },
+    { 17000, 0x749e, 0, 0, 63 },
+    { 18000, 0x74c2, 0x0600, 9, 1 },   // ENGINE_CRANK_SW off
+    { 19000, 0x7552, 0xffff, 0, 32768 },
+    { 20000, 0x7552, 0xffff, 0, 0 },   // Canopy closed
+    { 78000, 0x74c2, 0x0800, 11, 0 },  // APU off one minute after the second engine
+    { 78000, 0x74c2, 0x0100, 8, 0 },
+};
+
+/// Catapult launch: launch bar down, full power, WoW off and the launch bar retracting.
+const ExportScenarioStep OH_SCENARIO_CAT_LAUNCH[] PROGMEM = {
+    { 0, 0x74d8, 0x0100, 8, 1 },
+    { 0, 0x74d6, 0x4000, 14, 1 },
+    { 0, 0x74d6, 0x8000, 15, 1 },
+    { 0, 0x749e, 0, 0, 65 },
+    { 0, 0x74a2, 0, 0, 65 },
+    { 0, 0x7480, 0x2000, 13, 0 },      // LAUNCH_BAR_SW retract
+    { 1000, 0x7480, 0x2000, 13, 1 },   // LAUNCH_BAR_SW extend
+    { 4000, 0x749e, 0, 0, 85 },
+    { 4000, 0x74a2, 0, 0, 85 },
+    { 5000, 0x749e, 0, 0, 100 },
+    { 5000, 0x74a2, 0, 0, 100 },
+    { 7000, 0x74d6, 0x4000, 14, 0 },   // Off the deck, nose wheel first
+    { 7100, 0x74d8, 0x0100, 8, 0 },
+    { 7100, 0x74d6, 0x8000, 15, 0 },
+    { 7200, 0x7480, 0x2000, 13, 0 },
+    { 10000, 0x749e, 0, 0, 95 },
+    { 10000, 0x74a2, 0, 0, 95 },
+};
+
+/// Trap: hook down in the air, touchdown, full power and back to idle.
+const ExportScenarioStep OH_SCENARIO_TRAP[] PROGMEM = {
+    { 0, 0x74d8, 0x0100, 8, 0 },
+    { 0, 0x74d6, 0x4000, 14, 0 },
+    { 0, 0x74d6, 0x8000, 15, 0 },
+    { 0, 0x749e, 0, 0, 80 },
+    { 0, 0x74a2, 0, 0, 80 },
+    { 0, 0x74a0, 0x0200, 9, 0 },       // HOOK_LEVER up
+    { 1000, 0x74a0, 0x0200, 9, 1 },    // HOOK_LEVER down
+    { 6000, 0x74d8, 0x0100, 8, 1 },    // Main gear touches down
+    { 6000, 0x74d6, 0x8000, 15, 1 },
+    { 6050, 0x749e, 0, 0, 100 },
+    { 6050, 0x74a2, 0, 0, 100 },
+    { 6200, 0x74d6, 0x4000, 14, 1 },
+    { 8000, 0x749e, 0, 0, 65 },
+    { 8000, 0x74a2, 0, 0, 65 },
+    { 10000, 0x74a0, 0x0200, 9, 0 },
+};
+
+/**
+ * @class ExportGenerator
+ * @brief Builds export stream frames from a scenario, random words and string churn.
+ */
+class ExportGenerator {
+private:
+    ExportByteSink sink_;                         ///< Receives the stream.
+    unsigned int addresses_[OH_GENERATOR_WORDS];  ///< Export words that have a value.
+    unsigned int values_[OH_GENERATOR_WORDS];     ///< Value of each word.
+    bool dirty_[OH_GENERATOR_WORDS];              ///< True if the word has to be sent in the next frame.
+    byte words_;                                  ///< Number of words in use.
+    const ExportScenarioStep* scenario_;          ///< Steps of the scenario, in PROGMEM.
+    byte scenarioLength_;                         ///< Number of steps.
+    byte nextStep_;                               ///< Next step to apply.
+    unsigned long scenarioStart_;                 ///< millis() when the scenario started.
+    byte noiseWords_;                             ///< Random words per frame.
+    unsigned int noiseFirst_;                     ///< First address for random words.
+    unsigned int noiseLast_;                      ///< Last address for random words.
+    bool stringChurn_;                            ///< True if the fuel display changes every frame.
+    unsigned long fuel_;                          ///< Fuel shown by string churn.
+    unsigned int frameCounter_;                   ///< Value of the frame counter.
+    unsigned long bytesSent_;                     ///< Bytes sent since the start.
+
+    /**
+     * @return The slot of a word, taking a free one if the word has none. OH_GENERATOR_WORDS if all are taken.
+     */
+    byte slotOf(unsigned int address) {
+        address &= ~1U;
+        for (byte i = 0; i < words_; i++) {
+            if (addresses_[i] == address) {
+                return i;
+            }
+        }
+        if (words_ == OH_GENERATOR_WORDS) {
+            return OH_GENERATOR_WORDS;
+        }
+        addresses_[words_] = address;
+        values_[words_] = 0;
+        dirty_[words_] = true;
+        return words_++;
+    }
+
+    /**
+     * Sets bits of a word and marks it to be sent if they changed.
+     */
+    void setBits(unsigned int address, unsigned int mask, unsigned int bits) {
+        byte slot = slotOf(address);
+        if (slot == OH_GENERATOR_WORDS) {
+            return;
+        }
+        unsigned int value = (values_[slot] & ~mask) | (bits & mask);
+        if (value != values_[slot]) {
+            values_[slot] = value;
+            dirty_[slot] = true;
+        }
+    }
+
+    /**
+     * Writes a string into the words it covers, like DCS-BIOS does: the first character goes to the low byte.
+     */
+    void setString(unsigned int address, const char* text, byte length) {
+        for (byte i = 0; i < length; i++) {
+            unsigned int at = address + i;
+            byte shift = (at & 1) ? 8 : 0;
+            setBits(at, 0xFF << shift, (unsigned int)(byte)text[i] << shift);
+        }
+    }
+
+    /**
+     * Writes value right aligned into a string of length characters.
+     */
+    void setNumberString(unsigned int address, unsigned long value, byte length) {
+        char text[11];
+        for (byte i = length; i > 0; i--) {
+            text[i - 1] = (value > 0 || i == length) ? '0' + value % 10 : ' ';
+            value /= 10;
+        }
+        setString(address, text, length);
+    }
+
+    /**
+     * Applies the scenario steps that are due.
+     */
+    void runScenario(unsigned long nowMs) {
+        while (nextStep_ < scenarioLength_) {
+            ExportScenarioStep step;
+            memcpy_P(&step, &scenario_[nextStep_], sizeof(step));
+            if (nowMs - scenarioStart_ < step.timeMs) {
+                return;
+            }
+            if (step.mask == 0) {
+                setNumberString(step.address, step.value, 3);
+            } else {
+                setBits(step.address, step.mask, step.value << step.shift);
+            }
+            nextStep_++;
+        }
+    }
+
+    /**
+     * Sends a byte to the sink.
+     */
+    void put(byte b) {
+        sink_(b);
+        bytesSent_++;
+    }
+
+    /**
+     * Sends one block with one 16 bit word.
+     */
+    void putWord(unsigned int address, unsigned int value) {
+        put(address & 0xFF);
+        put(address >> 8);
+        put(2);
+        put(0);
+        put(value & 0xFF);
+        put(value >> 8);
+    }
+
+public:
+    /**
+     * @param sink Receives the generated stream.
+     */
+    ExportGenerator(ExportByteSink sink) {
+        sink_ = sink;
+        words_ = 0;
+        scenario_ = NULL;
+        scenarioLength_ = 0;
+        nextStep_ = 0;
+        scenarioStart_ = 0;
+        noiseWords_ = 0;
+        noiseFirst_ = OH_NOISE_FIRST_ADDRESS;
+        noiseLast_ = OH_NOISE_LAST_ADDRESS;
+        stringChurn_ = false;
+        fuel_ = 10800;
+        frameCounter_ = 0;
+        bytesSent_ = 0;
+    }
+
+    /**
+     * Starts a scenario. All words known so far are sent again in the next frame, like after a DCS restart.
+     * @param steps Steps of the scenario in PROGMEM, sorted by time.
+     * @param length Number of steps.
+     */
+    void startScenario(const ExportScenarioStep* steps, byte length) {
+        scenario_ = steps;
+        scenarioLength_ = length;
+        nextStep_ = 0;
+        scenarioStart_ = millis();
+        for (byte i = 0; i < words_; i++) {
+            dirty_[i] = true;
+        }
+    }
+
+    /**
+     * @return True once every step of the scenario was applied.
+     */
+    bool scenarioDone() {
+        return nextStep_ >= scenarioLength_;
+    }
+
+    /**
+     * Sets the change density.
+     * @param wordsPerFrame Random words added to every frame.
+     * @param first First address of the random words, no panel under test may listen to the range.
+     * @param last Last address of the random words.
+     */
+    void setNoise(byte wordsPerFrame, unsigned int first = OH_NOISE_FIRST_ADDRESS, unsigned int last = OH_NOISE_LAST_ADDRESS) {
+        noiseWords_ = wordsPerFrame;
+        noiseFirst_ = first & ~1U;
+        noiseLast_ = last & ~1U;
+    }
+
+    /**
+     * @param enabled True to change the IFEI fuel display in every frame.
+     */
+    void setStringChurn(bool enabled) {
+        stringChurn_ = enabled;
+    }
+
+    /**
+     * Builds and sends one frame.
+     * @return Number of bytes in the frame.
+     */
+    unsigned int sendFrame() {
+        unsigned long start = bytesSent_;
+        runScenario(millis());
+        if (stringChurn_ == true) {
+            fuel_ = (fuel_ > 0) ? fuel_ - 1 : 10800;
+            setNumberString(OH_FUEL_DOWN_ADDRESS, fuel_, OH_FUEL_DOWN_LENGTH);
+        }
+
+        for (byte i = 0; i < 4; i++) {
+            put(0x55);
+        }
+        for (byte i = 0; i < words_; i++) {
+            if (dirty_[i] == true) {
+                putWord(addresses_[i], values_[i]);
+                dirty_[i] = false;
+            }
+        }
+        for (byte i = 0; i < noiseWords_; i++) {
+            unsigned int address = noiseFirst_ + 2 * random((noiseLast_ - noiseFirst_) / 2 + 1);
+            byte slot = OH_GENERATOR_WORDS;
+            for (byte j = 0; j < words_; j++) {
+                if (addresses_[j] == address) {
+                    slot = j;
+                }
+            }
+            // Words with a scenario value are sent again unchanged, so the panel does not see fake switch moves.
+            putWord(address, (slot < OH_GENERATOR_WORDS) ? values_[slot] : (unsigned int)random(0x10000));
+        }
+        putWord(OH_FRAME_COUNTER_ADDRESS, ++frameCounter_ & 0xFF);
+        return bytesSent_ - start;
+    }
+
+    /**
+     * @return Bytes sent since the start.
+     */
+    unsigned long bytesSent() {
+        return bytesSent_;
+    }
+
+    /**
+     * @return Number of frames sent.
+     */
+    unsigned int framesSent() {
+        return frameCounter_;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
@@ -0,0 +1,191 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHIdentity.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Lets a panel tell the host which sketch it runs and which export addresses it listens to.
+ *
+ * Without this, the host has to be told per serial port which panel is connected. When the host writes a non zero
+ * value to OH_IDENTIFY, the panel answers with:
+ *
+ *     OH_IDENT <sketch> <build> <board>
+ *     OH_SUBS <index> <first>-<last> <first>-<last> ...
+ *     OH_SUBS_END <ranges>
+ *
+ * - **sketch** is the name of the sketch folder, which starts with the reference designator (`4A5A2-APU_PANEL`).
+ * - **build** is the `git describe` output of the firmware, set by openhornet.mk.
+ * - **board** is `promicro`, `promini`, `mega2560` or `s2mini`.
+ * - **OH_SUBS** lines list the export address ranges (hexadecimal, inclusive) of every DCS-BIOS listener in the
+ *   sketch, `index` being the number of ranges sent before. Overlapping and neighbouring ranges are merged. As many
+ *   lines follow as needed, then OH_SUBS_END gives the number of ranges so the host knows the list is complete.
+ *
+ * The list is read from the DCS-BIOS listener list itself, which is kept sorted by address, and the names are kept in
+ * flash. Identifying a panel does not take any RAM beyond the few bytes of this handler.
+ */
+
+#ifndef OH_IDENTITY_H
+#define OH_IDENTITY_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHListenerRanges.h"
+
+#define OH_IDENTIFY 0xFF14  ///< Host writes a non zero value to get the panel's identity.
+
+#ifndef OH_SKETCH_NAME
+#define OH_SKETCH_NAME "unknown"  ///< Name of the sketch folder, set by openhornet.mk.
+#endif
+
+#ifndef OH_BUILD_ID
+#define OH_BUILD_ID "unknown"  ///< Build ID of the firmware, set by openhornet.mk.
+#endif
+
+#ifndef OH_BOARD_NAME
+#if defined(__AVR_ATmega32U4__)
+#define OH_BOARD_NAME "promicro"  ///< Board the firmware was built for.
+#elif defined(__AVR_ATmega2560__)
+#define OH_BOARD_NAME "mega2560"
+#elif defined(__AVR_ATmega328P__)
+#define OH_BOARD_NAME "promini"
+#elif defined(ARDUINO_LOLIN_S2_MINI) || defined(CONFIG_IDF_TARGET_ESP32S2)
+#define OH_BOARD_NAME "s2mini"
+#else
+#define OH_BOARD_NAME "unknown"
+#endif
+#endif
+
+#define OH_SUBS_PER_LINE 4  ///< Address ranges per OH_SUBS line, so a line fits into OH_SERVICE_REPLY_LENGTH.
+
+namespace OpenHornet {
+
+const char OH_SKETCH_NAME_P[] PROGMEM = OH_SKETCH_NAME;  ///< Sketch name in flash.
+const char OH_BUILD_ID_P[] PROGMEM = OH_BUILD_ID;        ///< Build ID in flash.
+const char OH_BOARD_NAME_P[] PROGMEM = OH_BOARD_NAME;    ///< Board name in flash.
+
+/**
+ * @class Identity
+ * @brief Answers the host's identify request.
+ */
+class Identity : public ServiceHandler {
+private:
+    /// Steps of the answer.
+    enum State {
+        IDLE,
+        SEND_IDENT,
+        SEND_SUBS,
+        SEND_END
+    };
+
+    State state_;                                ///< What to send next.
+    DcsBios::ExportStreamListener* listener_;    ///< First listener not sent yet.
+    unsigned int rangesSent_;                    ///< Ranges sent so far.
+
+public:
+    Identity() {
+        state_ = IDLE;
+        listener_ = NULL;
+        rangesSent_ = 0;
+    }
+
+    /**
+     * Stores the host's identify request.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (address == OH_IDENTIFY && value != 0) {
+            state_ = SEND_IDENT;
+        }
+    }
+
+    /**
+     * Sends the next line of the answer. A line that can not be sent right now is sent again on the next call.
+     */
+    virtual void serviceLoop() {
+        ServiceReply reply;
+        switch (state_) {
+            case IDLE:
+                return;
+
+            case SEND_IDENT:
+                reply.addText_P(OH_SKETCH_NAME_P);
+                reply.addText_P(OH_BUILD_ID_P);
+                reply.addText_P(OH_BOARD_NAME_P);
+                if (reply.send("OH_IDENT")) {
+                    listener_ = DcsBios::ExportStreamListener::firstExportStreamListener;
+                    rangesSent_ = 0;
+                    state_ = (listener_ == NULL) ? SEND_END : SEND_SUBS;
+                }
+                return;
+
+            case SEND_SUBS: {
+                DcsBios::ExportStreamListener* next = listener_;
+                byte ranges = 0;
+                reply.addNumber(rangesSent_);
+                while (next != NULL && ranges < OH_SUBS_PER_LINE) {
+                    unsigned int first, last;
+                    nextListenerRange(next, first, last);
+                    char range[10];
+                    utoa(first, range, 16);
+                    byte length = strlen(range);
+                    range[length++] = '-';
+                    utoa(last, range + length, 16);
+                    reply.addText(range);
+                    ranges++;
+                }
+                if (reply.send("OH_SUBS")) {
+                    listener_ = next;
+                    rangesSent_ += ranges;
+                    if (listener_ == NULL) {
+                        state_ = SEND_END;
+                    }
+                }
+                return;
+            }
+
+            case SEND_END:
+                reply.addNumber(rangesSent_);
+                if (reply.send("OH_SUBS_END")) {
+                    state_ = IDLE;
+                }
+                return;
+        }
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
@@ -0,0 +1,309 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHInputState.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Lets the host read the physical position of switches and make single switches send again.
+ *
+ * At mission start, and whenever the sim moves a switch by itself, the pit and the sim can disagree. Sending every
+ * switch again fixes that but floods the link. Instead, a sketch declares a ReportedInput next to each switch the
+ * host should check. The host reads all positions at once, compares them with the export values of the same
+ * controls (MASTER_ARM_SW, GEAR_LEVER, APU_CONTROL_SW, ...) and asks only the switches that disagree to send again.
+ *
+ * Host writes on the service channel:
+ * Address           | Value
+ * ----------------- | -----
+ * OH_INPUT_DUMP     | OH_INPUT_POSITIONS for the positions, OH_INPUT_NAMES for the control names
+ * OH_INPUT_RESEND   | Index of the input + 1, or OH_INPUT_ALL for every DCS-BIOS input of the panel
+ *
+ * Replies, each split over as many lines as needed:
+ *
+ *     OH_INPUTS <first index> <positions>
+ *     OH_INPUT_NAMES <first index> <name> <name> ...
+ *     OH_INPUTS_END <number of inputs>
+ *
+ * Positions are one character per input, 0 to 9 and then a to z, with the value the switch sends to DCS-BIOS.
+ * Indexes count the ReportedInputs in the order they are declared, so they stay the same for one build (see
+ * OH_IDENT in OHIdentity.h) and the host only needs the names once per build.
+ *
+ * Positions are read from the pins right away, without debounce. A switch that is being moved can show a
+ * position it never sends, so the host should only act on a disagreement it sees in two dumps in a row.
+ */
+
+#ifndef OH_INPUT_STATE_H
+#define OH_INPUT_STATE_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+
+#define OH_INPUT_DUMP 0xFF1A    ///< Host writes OH_INPUT_POSITIONS or OH_INPUT_NAMES to get a dump.
+#define OH_INPUT_RESEND 0xFF1C  ///< Host writes the index of an input + 1 to make it send its position again.
+#define OH_INPUT_POSITIONS 1    ///< Dump the positions.
+#define OH_INPUT_NAMES 2        ///< Dump the control names.
+#define OH_INPUT_ALL 0xFFFF     ///< Make every DCS-BIOS input of the panel send again.
+
+namespace OpenHornet {
+
+/**
+ * @class InputState
+ * @brief Base class of an input that the host can read and make send again.
+ *
+ * Creating one appends it to the list of reported inputs.
+ */
+class InputState {
+private:
+    const char* msg_;         ///< DCS-BIOS command name of the input.
+    const byte* pins_;        ///< Pins of the positions, NULL for a two position switch on pin_.
+    byte pin_;                ///< Pin of a two position switch.
+    byte numberOfPins_;       ///< Number of entries in pins_.
+    InputState* next_;        ///< Next input in the list.
+
+public:
+    static InputState* first;  ///< First reported input.
+    static InputState* last;   ///< Last reported input.
+
+    /**
+     * Appends the input to the list.
+     * @param msg DCS-BIOS command name of the input.
+     * @param pins Pins of the positions, NULL for a two position switch.
+     * @param pin Pin of a two position switch.
+     * @param numberOfPins Number of entries in pins.
+     */
+    InputState(const char* msg, const byte* pins, byte pin, byte numberOfPins) {
+        msg_ = msg;
+        pins_ = pins;
+        pin_ = pin;
+        numberOfPins_ = numberOfPins;
+        next_ = NULL;
+        if (last == NULL) {
+            first = this;
+        } else {
+            last->next_ = this;
+        }
+        last = this;
+    }
+
+    /**
+     * Reads the position like the DCS-BIOS switch classes do: a two position switch is 1 while its pin is LOW,
+     * otherwise the position is the index of the first LOW pin, or of the DcsBios::PIN_NC entry if none is LOW.
+     * @return The position.
+     */
+    byte position() {
+        if (pins_ == NULL) {
+            return (digitalRead(pin_) == LOW) ? 1 : 0;
+        }
+        byte ncIndex = 0;
+        for (byte i = 0; i < numberOfPins_; i++) {
+            if (pins_[i] == DcsBios::PIN_NC) {
+                ncIndex = i;
+            } else if (digitalRead(pins_[i]) == LOW) {
+                return i;
+            }
+        }
+        return ncIndex;
+    }
+
+    /**
+     * @return The DCS-BIOS command name of the input.
+     */
+    const char* msg() {
+        return msg_;
+    }
+
+    /**
+     * @return The next input in the list, or NULL.
+     */
+    InputState* next() {
+        return next_;
+    }
+
+    /**
+     * Makes the DCS-BIOS input send its position on its next poll.
+     */
+    virtual void resend() = 0;
+};
+
+InputState* InputState::first = NULL;
+InputState* InputState::last = NULL;
+
+/**
+ * @class ReportedInput
+ * @brief Reports the position of a DCS-BIOS switch to the host.
+ * @tparam T Class of the switch, anything with resetThisState().
+ */
+template <class T>
+class ReportedInput : public InputState {
+private:
+    T& input_;  ///< The switch.
+
+public:
+    /**
+     * Reports a DcsBios::Switch2Pos.
+     * @param msg Command name of the switch.
+     * @param input The switch.
+     * @param pin Pin of the switch.
+     */
+    ReportedInput(const char* msg, T& input, byte pin)
+        : InputState(msg, NULL, pin, 0), input_(input) {}
+
+    /**
+     * Reports a switch with more positions. For a DcsBios::Switch3Pos on pinA and pinB, pass
+     * { pinA, DcsBios::PIN_NC, pinB }.
+     * @param msg Command name of the switch.
+     * @param input The switch.
+     * @param pins Pin of each position, DcsBios::PIN_NC for the position without a pin.
+     * @param numberOfPins Number of entries in pins.
+     */
+    ReportedInput(const char* msg, T& input, const byte* pins, byte numberOfPins)
+        : InputState(msg, pins, DcsBios::PIN_NC, numberOfPins), input_(input) {}
+
+    virtual void resend() {
+        input_.resetThisState();
+    }
+};
+
+/**
+ * @class InputDump
+ * @brief Answers the host's dump and resend requests.
+ */
+class InputDump : public ServiceHandler {
+private:
+    /// Steps of the answer.
+    enum State {
+        IDLE,
+        SEND_POSITIONS,
+        SEND_NAMES,
+        SEND_END
+    };
+
+    State state_;              ///< What to send next.
+    InputState* input_;        ///< First input not sent yet.
+    unsigned int index_;       ///< Index of input_.
+    unsigned int resend_;      ///< Pending resend request, 0 for none.
+
+public:
+    InputDump() {
+        state_ = IDLE;
+        input_ = NULL;
+        index_ = 0;
+        resend_ = 0;
+    }
+
+    /**
+     * Stores the host's dump and resend requests.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (address == OH_INPUT_DUMP) {
+            if (value == OH_INPUT_POSITIONS) {
+                state_ = SEND_POSITIONS;
+            } else if (value == OH_INPUT_NAMES) {
+                state_ = SEND_NAMES;
+            } else {
+                return;
+            }
+            input_ = InputState::first;
+            index_ = 0;
+        } else if (address == OH_INPUT_RESEND && value != 0) {
+            resend_ = value;
+        }
+    }
+
+    /**
+     * Carries out a resend request and sends the next line of a dump. A line that can not be sent right now is
+     * sent again on the next call.
+     */
+    virtual void serviceLoop() {
+        if (resend_ == OH_INPUT_ALL) {
+            DcsBios::resetAllStates();
+        } else if (resend_ != 0) {
+            unsigned int index = 1;
+            for (InputState* input = InputState::first; input != NULL; input = input->next(), index++) {
+                if (index == resend_) {
+                    input->resend();
+                    break;
+                }
+            }
+        }
+        resend_ = 0;
+
+        if (state_ == IDLE) {
+            return;
+        }
+        if (input_ == NULL) {
+            state_ = SEND_END;
+        }
+
+        ServiceReply reply;
+        if (state_ == SEND_END) {
+            reply.addNumber(index_);
+            if (reply.send("OH_INPUTS_END")) {
+                state_ = IDLE;
+            }
+            return;
+        }
+
+        reply.addNumber(index_);
+        InputState* next = input_;
+        unsigned int count = 0;
+        if (state_ == SEND_POSITIONS) {
+            char positions[OH_SERVICE_REPLY_LENGTH - 6];
+            while (next != NULL && count < sizeof(positions) - 1) {
+                byte position = next->position();
+                positions[count++] = (position < 10) ? '0' + position : 'a' + position - 10;
+                next = next->next();
+            }
+            positions[count] = '\0';
+            reply.addText(positions);
+        } else {
+            // Whole names only, at least one per line.
+            while (next != NULL && (count == 0 || strlen(reply.text()) + 1 + strlen(next->msg()) <= OH_SERVICE_REPLY_LENGTH)) {
+                reply.addText(next->msg());
+                next = next->next();
+                count++;
+            }
+        }
+        if (reply.send(state_ == SEND_POSITIONS ? "OH_INPUTS" : "OH_INPUT_NAMES")) {
+            input_ = next;
+            index_ += count;
+        }
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
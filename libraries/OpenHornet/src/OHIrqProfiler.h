@@ -0,0 +1,374 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHIrqProfiler.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Measures how long interrupts have to wait, and which code keeps them waiting.
+ *
+ * The USART receive buffer holds two bytes. At 250000 baud a byte arrives every 40 us, so a byte is lost when the
+ * receive interrupt waits more than OH_IRQ_BUDGET_US (80 us) to run. It waits while interrupts are disabled
+ * (millis() and micros(), NeoPixel show(), Wire transfers, EEPROM writes, critical sections of libraries) and
+ * while other interrupts run.
+ *
+ * With OH_IRQ_PROFILER defined before including OHPanel.h, a timer fires every OH_IRQ_PERIOD_US. On entry its
+ * interrupt reads how far the timer has counted since it fired, which is how long it had to wait, and the
+ * address it returns to, which is the instruction right after the code that kept it waiting. The longest waits
+ * are kept per return address. On the ATmega328P and ATmega2560 the USART receive interrupt has a lower priority
+ * than the timer, so it waits at least as long.
+ *
+ * Host tools read the results with OH_LATENCY_REPORT and clear them with OH_LATENCY_CLEAR, like the other latency
+ * probes. A report is one line
+ *
+ *     OH_IRQ <samples> <over OH_IRQ_TRACK_US> <over OH_IRQ_BUDGET_US> <max>
+ *
+ * followed by one line per tracked return address, longest wait first:
+ *
+ *     OH_IRQ_PC <address> <max> <over OH_IRQ_TRACK_US>
+ *
+ * with all times in microseconds. The address is the byte address in hexadecimal, as printed by
+ * `avr-objdump -d` or looked up with `avr-addr2line -e <elf> <address>`. A panel passes if nothing is over budget
+ * while it runs under the heaviest export load (see EXPORT_LOAD_GENERATOR).
+ *
+ * The timer is Timer2 on the ATmega328P and ATmega2560 and Timer3 on the ATmega32U4. It is started from the first
+ * OpenHornet::serviceLoop(), after the Arduino core set up the timers. While profiling, PWM on the pins of that
+ * timer and tone() do not work, and about 1% of the CPU time goes to the profiler.
+ *
+ * @note Only for AVR boards. This file defines the timer interrupt, so include it only from the sketch.
+ */
+
+#ifndef OH_IRQ_PROFILER_H
+#define OH_IRQ_PROFILER_H
+
+#ifdef OH_IRQ_PROFILER
+
+#include "Arduino.h"
+#include "OHService.h"
+#include "OHLatencyHistogram.h"
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega2560__)
+#define OH_IRQ_TIMER_vect TIMER2_COMPA_vect  ///< Compare interrupt of the profiler's timer.
+#define OH_IRQ_TCNT TCNT2                    ///< Counter of the profiler's timer.
+#define OH_IRQ_PRESCALER 32                  ///< Prescaler of the profiler's timer.
+#elif defined(__AVR_ATmega32U4__)
+#define OH_IRQ_TIMER_vect TIMER3_COMPA_vect
+#define OH_IRQ_TCNT TCNT3
+#define OH_IRQ_PRESCALER 8
+#define OH_IRQ_TIMER_16BIT  ///< The counter has two bytes.
+#else
+#error "OH_IRQ_PROFILER needs an ATmega328P, ATmega2560 or ATmega32U4."
+#endif
+
+#ifndef OH_IRQ_PERIOD_US
+#define OH_IRQ_PERIOD_US 500  ///< Time between two samples.
+#endif
+
+#ifndef OH_IRQ_BUDGET_US
+#define OH_IRQ_BUDGET_US 80  ///< Longest wait the USART receive buffer rides out at 250000 baud.
+#endif
+
+#ifndef OH_IRQ_TRACK_US
+#define OH_IRQ_TRACK_US 20  ///< Waits at least this long are kept per return address.
+#endif
+
+#ifndef OH_IRQ_TOP
+#define OH_IRQ_TOP 4  ///< Number of return addresses kept.
+#endif
+
+#define OH_IRQ_TICKS_TO_US(ticks) ((unsigned long)(ticks) * OH_IRQ_PRESCALER / (F_CPU / 1000000UL))  ///< Timer ticks to microseconds.
+
+volatile unsigned int ohIrqTicks;  ///< Timer count on entry of the profiler's interrupt, written by the entry code.
+volatile unsigned long ohIrqPc;    ///< Word address the profiler's interrupt returns to, written by the entry code.
+
+namespace OpenHornet {
+
+/**
+ * @class IrqProfiler
+ * @brief Keeps the interrupt waits measured by the timer interrupt and reports them.
+ */
+class IrqProfiler : public ServiceHandler {
+private:
+    /// Longest waits seen at one return address.
+    struct Offender {
+        unsigned long pc;      ///< Word address, 0 for an unused entry.
+        unsigned int maxUs;    ///< Longest wait.
+        unsigned int count;    ///< Waits over OH_IRQ_TRACK_US.
+    };
+
+    // Written only by the interrupt, read with interrupts disabled.
+    unsigned long samples_;           ///< Number of samples.
+    unsigned long overTrack_;         ///< Samples over OH_IRQ_TRACK_US.
+    unsigned long overBudget_;        ///< Samples over OH_IRQ_BUDGET_US.
+    unsigned int maxUs_;              ///< Longest wait.
+    unsigned long lastMicros_;        ///< micros() of the last sample.
+    unsigned int lastUs_;             ///< Wait of the last sample.
+    Offender top_[OH_IRQ_TOP];        ///< Longest waits by return address.
+
+    bool started_;                    ///< True once the timer runs.
+    byte reportLine_;                 ///< Next line of the report, 0 for none.
+    Offender sorted_[OH_IRQ_TOP];     ///< Copy of top_ taken for the report, longest wait first.
+
+    /**
+     * Sets the timer up to fire every OH_IRQ_PERIOD_US.
+     */
+    void start() {
+        noInterrupts();
+#ifdef OH_IRQ_TIMER_16BIT
+        TCCR3A = 0;
+        TCCR3B = _BV(WGM32) | _BV(CS31);  // CTC mode, clock / 8.
+        OCR3A = OH_IRQ_PERIOD_US * (F_CPU / 1000000UL) / OH_IRQ_PRESCALER - 1;
+        TCNT3 = 0;
+        TIFR3 = _BV(OCF3A);
+        TIMSK3 = _BV(OCIE3A);
+#else
+        TCCR2A = _BV(WGM21);               // CTC mode.
+        TCCR2B = _BV(CS21) | _BV(CS20);    // Clock / 32.
+        OCR2A = OH_IRQ_PERIOD_US * (F_CPU / 1000000UL) / OH_IRQ_PRESCALER - 1;
+        TCNT2 = 0;
+        TIFR2 = _BV(OCF2A);
+        TIMSK2 = _BV(OCIE2A);
+#endif
+        lastMicros_ = micros();
+        interrupts();
+        started_ = true;
+    }
+
+    /**
+     * Clears the results. Call it with interrupts disabled once the timer runs.
+     */
+    void clear() {
+        samples_ = 0;
+        overTrack_ = 0;
+        overBudget_ = 0;
+        maxUs_ = 0;
+        for (byte i = 0; i < OH_IRQ_TOP; i++) {
+            top_[i].pc = 0;
+            top_[i].maxUs = 0;
+            top_[i].count = 0;
+        }
+    }
+
+    /**
+     * Keeps a wait at a return address, replacing the entry with the shortest wait if the table is full.
+     * @param pc Word address the interrupt returned to.
+     * @param us The wait.
+     */
+    void track(unsigned long pc, unsigned int us) {
+        byte slot = 0;
+        for (byte i = 0; i < OH_IRQ_TOP; i++) {
+            if (top_[i].pc == pc) {
+                slot = i;
+                break;
+            }
+            if (top_[i].maxUs < top_[slot].maxUs) {
+                slot = i;
+            }
+        }
+        if (top_[slot].pc != pc) {
+            if (top_[slot].maxUs >= us) {
+                return;
+            }
+            top_[slot].pc = pc;
+            top_[slot].maxUs = 0;
+            top_[slot].count = 0;
+        }
+        if (us > top_[slot].maxUs) {
+            top_[slot].maxUs = us;
+        }
+        if (top_[slot].count < 0xFFFF) {
+            top_[slot].count++;
+        }
+    }
+
+public:
+    IrqProfiler() {
+        started_ = false;
+        reportLine_ = 0;
+        lastUs_ = 0;
+        lastMicros_ = 0;
+        clear();
+    }
+
+    /**
+     * Takes one sample, called from the timer interrupt.
+     */
+    void onTick() {
+        unsigned int us = OH_IRQ_TICKS_TO_US(ohIrqTicks);
+        unsigned long now = micros();
+        // The counter restarts every period, a wait longer than that shows as more time since the last sample.
+        unsigned long gap = now - lastMicros_ + lastUs_ - us;
+        unsigned int periods = (gap + OH_IRQ_PERIOD_US / 2) / OH_IRQ_PERIOD_US;
+        if (periods > 1) {
+            us += (periods - 1) * OH_IRQ_PERIOD_US;
+        }
+        lastMicros_ = now;
+        lastUs_ = us;
+
+        samples_++;
+        if (us > maxUs_) {
+            maxUs_ = us;
+        }
+        if (us > OH_IRQ_BUDGET_US) {
+            overBudget_++;
+        }
+        if (us >= OH_IRQ_TRACK_US) {
+            overTrack_++;
+            track(ohIrqPc, us);
+        }
+    }
+
+    /**
+     * Stores report and clear requests from the host.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (value == 0) {
+            return;
+        }
+        if (address == OH_LATENCY_REPORT) {
+            reportLine_ = 1;
+        } else if (address == OH_LATENCY_CLEAR) {
+            noInterrupts();
+            clear();
+            interrupts();
+        }
+    }
+
+    /**
+     * Starts the timer on the first call and sends the next line of a pending report.
+     */
+    virtual void serviceLoop() {
+        if (started_ == false) {
+            start();
+        }
+        if (reportLine_ == 0) {
+            return;
+        }
+
+        ServiceReply reply;
+        if (reportLine_ == 1) {
+            noInterrupts();
+            reply.addNumber(samples_);
+            reply.addNumber(overTrack_);
+            reply.addNumber(overBudget_);
+            reply.addNumber(maxUs_);
+            for (byte i = 0; i < OH_IRQ_TOP; i++) {
+                sorted_[i] = top_[i];
+            }
+            interrupts();
+            // Longest wait first, the table is too small to need more than a simple sort.
+            for (byte i = 1; i < OH_IRQ_TOP; i++) {
+                for (byte j = i; j > 0 && sorted_[j].maxUs > sorted_[j - 1].maxUs; j--) {
+                    Offender swap = sorted_[j];
+                    sorted_[j] = sorted_[j - 1];
+                    sorted_[j - 1] = swap;
+                }
+            }
+            if (reply.send("OH_IRQ")) {
+                reportLine_++;
+            }
+            return;
+        }
+
+        if (reportLine_ - 2 >= OH_IRQ_TOP || sorted_[reportLine_ - 2].pc == 0) {
+            reportLine_ = 0;
+            return;
+        }
+        Offender& offender = sorted_[reportLine_ - 2];
+        reply.addNumber(offender.pc * 2, 16);
+        reply.addNumber(offender.maxUs);
+        reply.addNumber(offender.count);
+        if (reply.send("OH_IRQ_PC")) {
+            reportLine_++;
+        }
+    }
+};
+
+IrqProfiler irqProfiler;  ///< The profiler of the sketch.
+
+}  // namespace OpenHornet
+
+/**
+ * Takes a sample after the entry code below. It is named like an interrupt vector, so that avr-gcc accepts the
+ * signal attribute: it saves every register it uses and returns with reti.
+ */
+extern "C" void __vector_oh_irq_profiler(void) __attribute__((signal, used));
+
+void __vector_oh_irq_profiler(void) {
+    OpenHornet::irqProfiler.onTick();
+}
+
+/**
+ * Entry code of the profiler's timer interrupt. It only uses instructions that do not change SREG, reads the
+ * timer count first, then the return address from the stack, and jumps to __vector_oh_irq_profiler.
+ * The return address sits above the three pushed registers, high byte first.
+ */
+ISR(OH_IRQ_TIMER_vect, ISR_NAKED) {
+    asm volatile(
+        "push r29              \n\t"
+        "push r30              \n\t"
+        "push r31              \n\t"
+        "lds r29, %[tcnt]      \n\t"
+        "sts %[ticks], r29     \n\t"
+#ifdef OH_IRQ_TIMER_16BIT
+        "lds r29, %[tcnt]+1    \n\t"
+        "sts %[ticks]+1, r29   \n\t"
+#endif
+        "in r30, __SP_L__      \n\t"
+        "in r31, __SP_H__      \n\t"
+#ifdef __AVR_3_BYTE_PC__
+        "ldd r29, Z+4          \n\t"
+        "sts %[pc]+2, r29      \n\t"
+        "ldd r29, Z+5          \n\t"
+        "sts %[pc]+1, r29      \n\t"
+        "ldd r29, Z+6          \n\t"
+        "sts %[pc], r29        \n\t"
+#else
+        "ldd r29, Z+4          \n\t"
+        "sts %[pc]+1, r29      \n\t"
+        "ldd r29, Z+5          \n\t"
+        "sts %[pc], r29        \n\t"
+#endif
+        "pop r31               \n\t"
+        "pop r30               \n\t"
+        "pop r29               \n\t"
+        "jmp __vector_oh_irq_profiler \n\t"
+        :
+        : [tcnt] "i"(_SFR_MEM_ADDR(OH_IRQ_TCNT)), [ticks] "i"(&ohIrqTicks), [pc] "i"(&ohIrqPc));
+}
+
+#endif  // OH_IRQ_PROFILER
+
+#endif
@@ -0,0 +1,424 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHIsrExportParser.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief DCS-BIOS serial backend that parses the export stream inside the receive interrupt.
+ *
+ * With DCSBIOS_IRQ_SERIAL the receive interrupt only stores bytes, and the export stream is parsed when loop() calls
+ * DcsBios::loop(). A slow loop delays every update and can overflow the receive buffer. This backend moves the parser
+ * into the interrupt instead:
+ *
+ * - The receive interrupt runs the frame and address state machine for every byte.
+ * - Only words in an address range that a listener of the sketch subscribes to are kept. Words whose value did not
+ *   change since the last frame are dropped, DCS-BIOS sends unchanged data again all the time. Service channel words
+ *   (OH_SERVICE_FIRST_ADDRESS and up) are never dropped, the host writes the same command twice on purpose.
+ * - What is left goes into a small queue of (address, value) pairs. DcsBios::loop() hands them to the listeners,
+ *   followed by onConsistentData() when the frame is complete.
+ *
+ * No receive buffer is needed any more, and how fast data is parsed no longer depends on loop() at all. If the queue
+ * is full, new changes are dropped without updating the cache of last values, so DCS-BIOS's next resend of the same
+ * data delivers them.
+ *
+ * To use it, define OH_ISR_EXPORT_PARSER instead of DCSBIOS_IRQ_SERIAL before including DcsBios.h, and include this
+ * file (or OHPanel.h) right after DcsBios.h. The sketch can not use Serial, this backend owns USART0.
+ *
+ * Like every backend it defines DcsBios::setup(), loop(), resetAllStates() and sendDcsBiosMessage(). DcsBios.h only
+ * declares sendDcsBiosMessage() before its inline tryToSendDcsBiosMessage() and the input classes, the definition
+ * here may come later.
+ *
+ * @note Only for the ATmega328P and ATmega2560. This file defines the USART0 interrupts, so include it only from the sketch.
+ */
+
+#ifndef OH_ISR_EXPORT_PARSER_H
+#define OH_ISR_EXPORT_PARSER_H
+
+#ifdef OH_ISR_EXPORT_PARSER
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHListenerRanges.h"
+#include "OHService.h"
+
+#if !defined(__AVR_ATmega328P__) && !defined(__AVR_ATmega2560__)
+#error "OH_ISR_EXPORT_PARSER needs the USART0 of an ATmega328P or ATmega2560."
+#endif
+
+#if defined(DCSBIOS_IRQ_SERIAL) || defined(DCSBIOS_DEFAULT_SERIAL) || defined(OH_BATCHED_SERIAL)
+#error "Define only one of OH_ISR_EXPORT_PARSER, OH_BATCHED_SERIAL, DCSBIOS_IRQ_SERIAL and DCSBIOS_DEFAULT_SERIAL."
+#endif
+
+#ifndef OH_ISR_RANGES
+#define OH_ISR_RANGES 16  ///< Number of subscribed address ranges checked in the interrupt, the last one grows to cover any more.
+#endif
+
+#ifndef OH_ISR_CACHE_WORDS
+#define OH_ISR_CACHE_WORDS 64  ///< Number of subscribed words whose last value is kept, words beyond are always queued.
+#endif
+
+#ifndef OH_ISR_QUEUE_LENGTH
+#define OH_ISR_QUEUE_LENGTH 32  ///< Number of changes the queue holds, a power of two.
+#endif
+
+#ifndef OH_ISR_TX_LENGTH
+#define OH_ISR_TX_LENGTH 64  ///< Size of the transmit buffer for commands, a power of two.
+#endif
+
+#define OH_ISR_FRAME_END 0xFFFF  ///< Address used in the queue to mark the end of a frame, export addresses are even.
+
+#ifdef USART0_RX_vect
+#define OH_USART_RX_vect USART0_RX_vect      ///< Receive interrupt of USART0 (ATmega2560).
+#define OH_USART_UDRE_vect USART0_UDRE_vect  ///< Transmit buffer empty interrupt of USART0 (ATmega2560).
+#else
+#define OH_USART_RX_vect USART_RX_vect      ///< Receive interrupt of USART0 (ATmega328P).
+#define OH_USART_UDRE_vect USART_UDRE_vect  ///< Transmit buffer empty interrupt of USART0 (ATmega328P).
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class IsrExportParser
+ * @brief Export stream parser and command transmitter on USART0.
+ */
+class IsrExportParser {
+private:
+    /// States of the export stream parser.
+    enum State {
+        WAIT_FOR_SYNC,
+        ADDRESS_LOW,
+        ADDRESS_HIGH,
+        COUNT_LOW,
+        COUNT_HIGH,
+        DATA_LOW,
+        DATA_HIGH
+    };
+
+    // Written only by the interrupt.
+    State state_;                                              ///< State of the parser.
+    byte syncCount_;                                           ///< Number of 0x55 bytes in a row.
+    unsigned int address_;                                     ///< Address of the next word.
+    unsigned int count_;                                       ///< Bytes left in the block.
+    unsigned int data_;                                        ///< Word being received.
+    unsigned int cache_[OH_ISR_CACHE_WORDS];                   ///< Last queued value of each cached word.
+    byte cacheValid_[(OH_ISR_CACHE_WORDS + 7) / 8];            ///< One bit per cached word, set once it has a value.
+
+    // Set up by begin(), read by the interrupt.
+    unsigned int rangeFirst_[OH_ISR_RANGES];                   ///< First address of each subscribed range.
+    unsigned int rangeLast_[OH_ISR_RANGES];                    ///< Last address of each subscribed range.
+    unsigned int rangeCacheIndex_[OH_ISR_RANGES];              ///< Cache index of the first word of each range.
+    byte ranges_;                                              ///< Number of ranges in use.
+
+    // Queue from the interrupt to loop().
+    volatile unsigned int queueAddress_[OH_ISR_QUEUE_LENGTH];  ///< Address of each queued change.
+    volatile unsigned int queueValue_[OH_ISR_QUEUE_LENGTH];    ///< Value of each queued change.
+    volatile byte queueHead_;                                  ///< Next entry written by the interrupt.
+    volatile byte queueTail_;                                  ///< Next entry read by loop().
+    volatile unsigned int dropped_;                            ///< Changes dropped because the queue was full.
+    volatile byte maxDepth_;                                   ///< Most entries ever waiting in the queue.
+
+    // Commands to the host.
+    volatile byte tx_[OH_ISR_TX_LENGTH];                       ///< Transmit buffer.
+    volatile byte txHead_;                                     ///< Next byte written by sendDcsBiosMessage().
+    volatile byte txTail_;                                     ///< Next byte sent by the interrupt.
+
+    /**
+     * Queues a change, called only from the interrupt.
+     * @return False if the queue is full.
+     */
+    bool enqueue(unsigned int address, unsigned int value) {
+        byte next = (queueHead_ + 1) & (OH_ISR_QUEUE_LENGTH - 1);
+        if (next == queueTail_) {
+            dropped_++;
+            return false;
+        }
+        queueAddress_[queueHead_] = address;
+        queueValue_[queueHead_] = value;
+        queueHead_ = next;
+        byte depth = (queueHead_ - queueTail_) & (OH_ISR_QUEUE_LENGTH - 1);
+        if (depth > maxDepth_) {
+            maxDepth_ = depth;
+        }
+        return true;
+    }
+
+    /**
+     * Queues a received word if it is subscribed and changed, called only from the interrupt.
+     */
+    void onWord(unsigned int address, unsigned int value) {
+        for (byte i = 0; i < ranges_; i++) {
+            if (address < rangeFirst_[i]) {
+                break;  // Ranges are sorted.
+            }
+            if (address <= rangeLast_[i]) {
+                unsigned int index = rangeCacheIndex_[i] + (address - rangeFirst_[i]) / 2;
+                if (index >= OH_ISR_CACHE_WORDS || address >= OH_SERVICE_FIRST_ADDRESS) {
+                    enqueue(address, value);
+                    break;
+                }
+                byte bit = 1 << (index & 7);
+                if ((cacheValid_[index / 8] & bit) && cache_[index] == value) {
+                    break;  // Unchanged.
+                }
+                if (enqueue(address, value)) {
+                    cache_[index] = value;
+                    cacheValid_[index / 8] |= bit;
+                }
+                break;
+            }
+        }
+        if (address == 0xFFFE) {
+            enqueue(OH_ISR_FRAME_END, 0);
+        }
+    }
+
+public:
+    IsrExportParser() {
+        state_ = WAIT_FOR_SYNC;
+        syncCount_ = 0;
+        address_ = 0;
+        count_ = 0;
+        data_ = 0;
+        ranges_ = 0;
+        queueHead_ = 0;
+        queueTail_ = 0;
+        dropped_ = 0;
+        maxDepth_ = 0;
+        txHead_ = 0;
+        txTail_ = 0;
+        for (byte i = 0; i < sizeof(cacheValid_); i++) {
+            cacheValid_[i] = 0;
+        }
+    }
+
+    /**
+     * Reads the subscribed ranges from the listener list and starts USART0 at 250000 baud.
+     * Called by DcsBios::setup(), once every listener exists.
+     */
+    void begin() {
+        DcsBios::ExportStreamListener* listener = DcsBios::ExportStreamListener::firstExportStreamListener;
+        unsigned int cacheIndex = 0;
+        ranges_ = 0;
+        while (listener != NULL) {
+            unsigned int first, last;
+            nextListenerRange(listener, first, last);
+            if (ranges_ == OH_ISR_RANGES) {
+                rangeLast_[ranges_ - 1] = last;  // Out of ranges, grow the last one.
+                continue;
+            }
+            rangeFirst_[ranges_] = first & ~1U;
+            rangeLast_[ranges_] = last;
+            rangeCacheIndex_[ranges_] = cacheIndex;
+            cacheIndex += (last - first) / 2 + 1;
+            ranges_++;
+        }
+
+        UBRR0H = 0;
+        UBRR0L = 7;  // 250000 baud at 16 MHz with U2X0.
+        UCSR0A = _BV(U2X0);
+        UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+        UCSR0B = _BV(RXEN0) | _BV(TXEN0) | _BV(RXCIE0);
+    }
+
+    /**
+     * Runs the parser on one received byte, called only from the receive interrupt.
+     * Works like the DCS-BIOS ProtocolParser: four 0x55 bytes in a row start a frame in any state.
+     */
+    void processByte(byte c) {
+        switch (state_) {
+            case WAIT_FOR_SYNC:
+                break;
+            case ADDRESS_LOW:
+                address_ = c;
+                state_ = ADDRESS_HIGH;
+                break;
+            case ADDRESS_HIGH:
+                address_ |= (unsigned int)c << 8;
+                state_ = (address_ != 0x5555) ? COUNT_LOW : WAIT_FOR_SYNC;
+                break;
+            case COUNT_LOW:
+                count_ = c;
+                state_ = COUNT_HIGH;
+                break;
+            case COUNT_HIGH:
+                count_ |= (unsigned int)c << 8;
+                state_ = DATA_LOW;
+                break;
+            case DATA_LOW:
+                data_ = c;
+                count_--;
+                state_ = DATA_HIGH;
+                break;
+            case DATA_HIGH:
+                data_ |= (unsigned int)c << 8;
+                count_--;
+                onWord(address_, data_);
+                address_ += 2;
+                state_ = (count_ == 0) ? ADDRESS_LOW : DATA_LOW;
+                break;
+        }
+
+        if (c == 0x55) {
+            syncCount_++;
+        } else {
+            syncCount_ = 0;
+        }
+        if (syncCount_ == 4) {
+            state_ = ADDRESS_LOW;
+            syncCount_ = 0;
+        }
+    }
+
+    /**
+     * Hands every queued change to the listeners, called by DcsBios::loop().
+     */
+    void dispatch() {
+        while (queueTail_ != queueHead_) {
+            byte tail = queueTail_;
+            unsigned int address = queueAddress_[tail];
+            unsigned int value = queueValue_[tail];
+            queueTail_ = (tail + 1) & (OH_ISR_QUEUE_LENGTH - 1);
+
+            if (address == OH_ISR_FRAME_END) {
+                for (DcsBios::ExportStreamListener* l = DcsBios::ExportStreamListener::firstExportStreamListener; l != NULL; l = l->nextExportStreamListener) {
+                    l->onConsistentData();
+                }
+            } else {
+                DcsBios::ExportStreamListener::handleDcsBiosWrite(address, value);
+            }
+        }
+    }
+
+    /**
+     * Puts a byte into the transmit buffer, waiting while it is full.
+     */
+    void write(byte c) {
+        byte next = (txHead_ + 1) & (OH_ISR_TX_LENGTH - 1);
+        while (next == txTail_) {
+            // The transmit interrupt empties the buffer.
+        }
+        tx_[txHead_] = c;
+        txHead_ = next;
+        UCSR0B |= _BV(UDRIE0);
+    }
+
+    /**
+     * Sends the next buffered byte, called only from the transmit interrupt.
+     */
+    void transmitNext() {
+        if (txTail_ == txHead_) {
+            UCSR0B &= ~_BV(UDRIE0);
+            return;
+        }
+        UDR0 = tx_[txTail_];
+        txTail_ = (txTail_ + 1) & (OH_ISR_TX_LENGTH - 1);
+    }
+
+    /**
+     * @return Number of changes dropped because the queue was full.
+     */
+    unsigned int droppedChanges() {
+        noInterrupts();
+        unsigned int dropped = dropped_;
+        interrupts();
+        return dropped;
+    }
+
+    /**
+     * @return Most changes that ever waited in the queue, shows how much of OH_ISR_QUEUE_LENGTH is used.
+     */
+    byte maxQueueDepth() {
+        return maxDepth_;
+    }
+};
+
+IsrExportParser isrExportParser;  ///< The one parser on USART0.
+
+}  // namespace OpenHornet
+
+ISR(OH_USART_RX_vect) {
+    OpenHornet::isrExportParser.processByte(UDR0);
+}
+
+ISR(OH_USART_UDRE_vect) {
+    OpenHornet::isrExportParser.transmitNext();
+}
+
+namespace DcsBios {
+
+/**
+ * Starts the interrupt driven parser. Call it from setup() as with the other DCS-BIOS backends.
+ */
+void setup() {
+    OpenHornet::isrExportParser.begin();
+}
+
+/**
+ * Dispatches the queued export changes, then polls the inputs.
+ */
+void loop() {
+    OpenHornet::isrExportParser.dispatch();
+    PollingInput::pollInputs();
+    ExportStreamListener::loopAll();
+}
+
+/**
+ * Sends a command line to the host.
+ * @param msg Name of the control.
+ * @param arg Argument of the command.
+ */
+void sendDcsBiosMessage(const char* msg, const char* arg) {
+    while (*msg != '\0') {
+        OpenHornet::isrExportParser.write(*msg++);
+    }
+    OpenHornet::isrExportParser.write(' ');
+    while (*arg != '\0') {
+        OpenHornet::isrExportParser.write(*arg++);
+    }
+    OpenHornet::isrExportParser.write('\n');
+    PollingInput::setMessageSentOrQueued();
+}
+
+/**
+ * Makes every input send its state again on the next poll, as the other DCS-BIOS backends do.
+ */
+void resetAllStates() {
+    PollingInput::resetAllStates();
+}
+
+}  // namespace DcsBios
+
+#endif
+
+#endif
@@ -0,0 +1,394 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHKeypadMatrix.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Scans a button matrix (UFC keypad and similar grids) from a timer interrupt and sends the buttons to DCS-BIOS.
+ *
+ * A keypad with R rows and C columns needs only R + C pins instead of R x C. One column is pulled LOW at a time,
+ * and the rows show which buttons in that column are pressed.
+ *
+ * The scan runs from the Timer0 compare interrupt, which fires about every 1.024 ms next to the millis() counter
+ * without changing it. On each tick the rows of the active column are read as one snapshot, then the next column is
+ * driven. The whole matrix is therefore scanned every C ticks, no matter how long loop() takes.
+ *
+ * The buttons are debounced in bulk: every column has a two bit counter per row, and a button only changes state after
+ * four scans in a row agree. With 6 columns that is 4 x 6 x 1.024 ms, about 25 ms.
+ *
+ * Without a diode on every button, pressing three buttons on the corners of a rectangle makes the fourth corner read
+ * as pressed too ("ghosting"). When two columns share two or more pressed rows, no new presses in those rows and
+ * columns are sent until the ambiguity is gone. Releases are always sent, ghosting can only add buttons.
+ *
+ * A KeypadMatrix is a DcsBios::PollingInput like the DCS-BIOS switches: DcsBios::loop() sends its buttons, and
+ * DcsBios::resetAllStates() makes it send all of them again.
+ *
+ * ### Timer0:
+ * On AVR boards begin() sets OCR0A to 0x80 and enables the Timer0 compare A interrupt, and this file defines
+ * ISR(TIMER0_COMPA_vect). Timer0 itself keeps running as the Arduino core set it up, so millis(), micros() and
+ * delay() are not affected. Other users of Timer0 are:
+ * - **Code that also defines ISR(TIMER0_COMPA_vect):** the sketch does not link (multiple definition of the
+ *   vector). Only one KeypadMatrix per sketch can use the timer, and no other library may use that interrupt.
+ * - **analogWrite() on the OC0A pin** (pin 6 on the ATmega328P, pin 13 on the Mega, PB7 on the ATmega32U4, which
+ *   the Pro Micro does not break out): it writes OCR0A, so the pin's duty and the moment of the tick within the
+ *   1.024 ms period change. The scan keeps its rate, but the pin does not get the duty that was asked for, so
+ *   don't use PWM on that pin.
+ * - **Code that clears OCIE0A in TIMSK0 or changes the Timer0 prescaler:** stops or slows the scan. The Arduino
+ *   core does neither.
+ *
+ * @note This file defines the Timer0 compare interrupt, so include it only from the sketch.
+ */
+
+#ifndef OH_KEYPAD_MATRIX_H
+#define OH_KEYPAD_MATRIX_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+
+#ifndef OH_KEYPAD_MAX_COLUMNS
+#define OH_KEYPAD_MAX_COLUMNS 8  ///< Largest number of columns. Rows are limited to 8 (one byte per column).
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class KeypadMatrix
+ * @brief Timer driven button matrix with bulk debounce and ghost detection.
+ *
+ * Button messages are given as one array of DCS-BIOS control names in row order:
+ * the button in row r and column c uses keyMessages[r * numberOfColumns + c]. Use NULL for an empty position.
+ * Call begin() in setup(), DcsBios::loop() polls the matrix.
+ */
+class KeypadMatrix : DcsBios::PollingInput {
+private:
+    const byte* rowPins_;                                 ///< Arduino pins of the rows, read with pull-ups.
+    byte numberOfRows_;                                   ///< Number of rows, up to 8.
+    const byte* columnPins_;                              ///< Arduino pins of the columns, driven LOW one at a time.
+    byte numberOfColumns_;                                ///< Number of columns, up to OH_KEYPAD_MAX_COLUMNS.
+    const char* const* keyMessages_;                      ///< DCS-BIOS control names in row order.
+    volatile byte activeColumn_;                          ///< The column that is driven LOW right now.
+    volatile byte debounced_[OH_KEYPAD_MAX_COLUMNS];      ///< Debounced pressed rows per column, written by the interrupt.
+    byte counterLow_[OH_KEYPAD_MAX_COLUMNS];              ///< Low bit of the debounce counter of every row, per column.
+    byte counterHigh_[OH_KEYPAD_MAX_COLUMNS];             ///< High bit of the debounce counter of every row, per column.
+    byte reported_[OH_KEYPAD_MAX_COLUMNS];                ///< Pressed rows per column as last sent to DCS.
+    volatile unsigned long scans_;                        ///< Number of complete scans of the matrix.
+    bool ghosting_;                                       ///< True when the last check found ambiguous buttons.
+    unsigned long lastTickMicros_;                        ///< Time of the last tick when no timer is available.
+#ifdef __AVR__
+    volatile uint8_t* rowInput_[8];                       ///< Input register of every row pin.
+    uint8_t rowMask_[8];                                  ///< Bit of every row pin in its input register.
+    bool rowsShareOnePort_;                               ///< True when all rows are on one port and can be read with one access.
+    volatile uint8_t* columnMode_[OH_KEYPAD_MAX_COLUMNS];   ///< Direction register of every column pin.
+    volatile uint8_t* columnOutput_[OH_KEYPAD_MAX_COLUMNS]; ///< Output register of every column pin.
+    uint8_t columnMask_[OH_KEYPAD_MAX_COLUMNS];           ///< Bit of every column pin in its registers.
+#endif
+
+    /**
+     * Reads all rows of the active column.
+     * @return One bit per row, set when the button is pressed (row pulled LOW).
+     */
+    byte readRows() {
+        byte pressed = 0;
+#ifdef __AVR__
+        if (rowsShareOnePort_ == true) {
+            byte snapshot = *rowInput_[0];
+            for (byte row = 0; row < numberOfRows_; row++) {
+                if ((snapshot & rowMask_[row]) == 0) {
+                    pressed |= (1 << row);
+                }
+            }
+            return pressed;
+        }
+        for (byte row = 0; row < numberOfRows_; row++) {
+            if ((*rowInput_[row] & rowMask_[row]) == 0) {
+                pressed |= (1 << row);
+            }
+        }
+#else
+        for (byte row = 0; row < numberOfRows_; row++) {
+            if (digitalRead(rowPins_[row]) == LOW) {
+                pressed |= (1 << row);
+            }
+        }
+#endif
+        return pressed;
+    }
+
+    /**
+     * Drives a column LOW, so the buttons in this column pull their rows LOW.
+     * @param column Column index.
+     */
+    void driveColumn(byte column) {
+#ifdef __AVR__
+        *columnOutput_[column] &= ~columnMask_[column];
+        *columnMode_[column] |= columnMask_[column];
+#else
+        pinMode(columnPins_[column], OUTPUT);
+        digitalWrite(columnPins_[column], LOW);
+#endif
+    }
+
+    /**
+     * Releases a column (input without pull-up), so pressing two buttons in one row can not short two columns.
+     * @param column Column index.
+     */
+    void releaseColumn(byte column) {
+#ifdef __AVR__
+        *columnMode_[column] &= ~columnMask_[column];
+        *columnOutput_[column] &= ~columnMask_[column];
+#else
+        pinMode(columnPins_[column], INPUT);
+#endif
+    }
+
+    /**
+     * Checks every pair of columns for two or more shared pressed rows.
+     * @param state Debounced pressed rows per column.
+     * @param ambiguous Filled with the rows per column that may be ghosts.
+     * @return True if any button may be a ghost.
+     */
+    bool findGhosts(const byte* state, byte* ambiguous) {
+        bool found = false;
+        for (byte column = 0; column < numberOfColumns_; column++) {
+            ambiguous[column] = 0;
+        }
+        // Compare each column with every column after it.
+        for (byte first = 0; first < numberOfColumns_; first++) {
+            for (byte second = first + 1; second < numberOfColumns_; second++) {
+                byte shared = state[first] & state[second];
+                if ((shared & (shared - 1)) != 0) {  // More than one bit set.
+                    ambiguous[first] |= shared;
+                    ambiguous[second] |= shared;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Sends every button whose debounced state differs from what DCS last got.
+     * New presses of buttons that may be ghosts are held back until the matrix is unambiguous.
+     */
+    void pollInput() {
+#ifndef __AVR__
+        // No timer interrupt, tick from the loop at the same rate.
+        while ((micros() - lastTickMicros_) >= 1024) {
+            lastTickMicros_ += 1024;
+            scanTick();
+        }
+#endif
+        byte state[OH_KEYPAD_MAX_COLUMNS];
+        byte ambiguous[OH_KEYPAD_MAX_COLUMNS];
+
+        // Copy the debounced state in one piece, the interrupt may update it at any time.
+        noInterrupts();
+        for (byte column = 0; column < numberOfColumns_; column++) {
+            state[column] = debounced_[column];
+        }
+        interrupts();
+
+        ghosting_ = findGhosts(state, ambiguous);
+
+        // Send every changed button, column by column.
+        for (byte column = 0; column < numberOfColumns_; column++) {
+            byte changed = state[column] ^ reported_[column];
+            for (byte row = 0; changed != 0 && row < numberOfRows_; row++) {
+                byte bit = 1 << row;
+                if ((changed & bit) == 0) {
+                    continue;
+                }
+                changed &= ~bit;
+
+                bool pressed = (state[column] & bit) != 0;
+                if (pressed == true && (ambiguous[column] & bit) != 0) {
+                    continue;  // May be a ghost, wait.
+                }
+
+                const char* msg = keyMessages_[row * numberOfColumns_ + column];
+                if (msg == NULL || DcsBios::tryToSendDcsBiosMessage(msg, pressed ? "1" : "0")) {
+                    reported_[column] ^= bit;
+                }
+            }
+        }
+    }
+
+    /**
+     * Sends the state of every button again on the next poll, called by DcsBios::resetAllStates().
+     */
+    void resetState() {
+        for (byte column = 0; column < numberOfColumns_; column++) {
+            // Only the row bits, pollInput() never clears the others.
+            reported_[column] = ~debounced_[column] & (byte)((1 << numberOfRows_) - 1);
+        }
+    }
+
+public:
+    static KeypadMatrix* timerMatrix;  ///< The matrix scanned by the timer interrupt.
+
+    /**
+     * Constructor for a button matrix.
+     * @param rowPins Array of Arduino pins connected to the rows.
+     * @param numberOfRows Number of rows, up to 8.
+     * @param columnPins Array of Arduino pins connected to the columns.
+     * @param numberOfColumns Number of columns, up to OH_KEYPAD_MAX_COLUMNS.
+     * @param keyMessages DCS-BIOS control names in row order, NULL for an empty position.
+     */
+    KeypadMatrix(const byte* rowPins, byte numberOfRows, const byte* columnPins, byte numberOfColumns, const char* const* keyMessages)
+        : DcsBios::PollingInput(POLL_EVERY_TIME) {
+        rowPins_ = rowPins;
+        numberOfRows_ = (numberOfRows > 8) ? 8 : numberOfRows;
+        columnPins_ = columnPins;
+        numberOfColumns_ = (numberOfColumns > OH_KEYPAD_MAX_COLUMNS) ? OH_KEYPAD_MAX_COLUMNS : numberOfColumns;
+        keyMessages_ = keyMessages;
+        activeColumn_ = 0;
+        scans_ = 0;
+        ghosting_ = false;
+        lastTickMicros_ = 0;
+        for (byte column = 0; column < OH_KEYPAD_MAX_COLUMNS; column++) {
+            debounced_[column] = 0;
+            counterLow_[column] = 0xFF;
+            counterHigh_[column] = 0xFF;
+            reported_[column] = 0;
+        }
+    }
+
+    /**
+     * Sets up the pins and starts the scan on the Timer0 compare interrupt.
+     * On boards without Timer0 the scan runs from the poll instead.
+     */
+    void begin() {
+        for (byte row = 0; row < numberOfRows_; row++) {
+            pinMode(rowPins_[row], INPUT_PULLUP);
+        }
+        for (byte column = 0; column < numberOfColumns_; column++) {
+            pinMode(columnPins_[column], INPUT);
+        }
+#ifdef __AVR__
+        rowsShareOnePort_ = true;
+        for (byte row = 0; row < numberOfRows_; row++) {
+            rowInput_[row] = portInputRegister(digitalPinToPort(rowPins_[row]));
+            rowMask_[row] = digitalPinToBitMask(rowPins_[row]);
+            if (rowInput_[row] != rowInput_[0]) {
+                rowsShareOnePort_ = false;
+            }
+        }
+        for (byte column = 0; column < numberOfColumns_; column++) {
+            columnMode_[column] = portModeRegister(digitalPinToPort(columnPins_[column]));
+            columnOutput_[column] = portOutputRegister(digitalPinToPort(columnPins_[column]));
+            columnMask_[column] = digitalPinToBitMask(columnPins_[column]);
+        }
+        driveColumn(0);
+        timerMatrix = this;
+        OCR0A = 0x80;              // Fire half way between two millis() overflows.
+        TIMSK0 |= _BV(OCIE0A);     // Enable the Timer0 compare A interrupt.
+#else
+        driveColumn(0);
+        lastTickMicros_ = micros();
+#endif
+    }
+
+    /**
+     * One scan step: debounces the rows of the active column, then drives the next column.
+     * The rows had a whole tick to settle since the column was driven.
+     * Called from the timer interrupt, do not call it from the sketch.
+     */
+    void scanTick() {
+        byte column = activeColumn_;
+        byte changed = debounced_[column] ^ readRows();
+
+        // Two bit vertical counter: a row toggles after four samples in a row that differ from its debounced state.
+        counterLow_[column] = ~(counterLow_[column] & changed);
+        counterHigh_[column] = counterLow_[column] ^ (counterHigh_[column] & changed);
+        changed &= counterLow_[column] & counterHigh_[column];
+        debounced_[column] ^= changed;
+
+        releaseColumn(column);
+        column++;
+        if (column >= numberOfColumns_) {
+            column = 0;
+            scans_++;
+        }
+        driveColumn(column);
+        activeColumn_ = column;
+    }
+
+    /**
+     * Polls the matrix right away, as the DCS-BIOS switch classes allow. DcsBios::loop() already polls it.
+     */
+    void pollThisInput() {
+        this->pollInput();
+    }
+
+    /**
+     * Sends the state of every button again on the next poll.
+     */
+    void resetThisState() {
+        this->resetState();
+    }
+
+    /**
+     * @return True if the last poll held back presses because of possible ghosting.
+     */
+    bool isGhosting() {
+        return ghosting_;
+    }
+
+    /**
+     * @return The number of complete scans of the matrix since begin().
+     */
+    unsigned long scansCompleted() {
+        noInterrupts();
+        unsigned long scans = scans_;
+        interrupts();
+        return scans;
+    }
+};
+
+KeypadMatrix* KeypadMatrix::timerMatrix = NULL;
+
+}  // namespace OpenHornet
+
+#ifdef __AVR__
+/**
+ * Timer0 compare interrupt, about every 1.024 ms. Advances the scan of the matrix by one column.
+ */
+ISR(TIMER0_COMPA_vect) {
+    if (OpenHornet::KeypadMatrix::timerMatrix != NULL) {
+        OpenHornet::KeypadMatrix::timerMatrix->scanTick();
+    }
+}
+#endif
+
+#endif
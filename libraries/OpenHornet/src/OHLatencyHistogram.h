@@ -0,0 +1,177 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHLatencyHistogram.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Small histogram of latencies in microseconds, with percentiles.
+ *
+ * A panel does not have the RAM to keep every sample. The histogram keeps one counter per power of two
+ * (bucket i counts latencies from 2^i to 2^(i+1) - 1 microseconds) plus the exact minimum and maximum.
+ * Percentiles are interpolated inside their bucket, so they are off by less than the width of that bucket.
+ * That is good enough to tell a 4 ms from a 40 ms delay, which is what the measurements are for.
+ *
+ * The latency probes built on it (OHEchoLatency.h, OHActuatorLatency.h) are read out and cleared together by host tools,
+ * through OH_LATENCY_REPORT and OH_LATENCY_CLEAR on the service channel. So is the interrupt profiler (OHIrqProfiler.h).
+ */
+
+#ifndef OH_LATENCY_HISTOGRAM_H
+#define OH_LATENCY_HISTOGRAM_H
+
+#include "Arduino.h"
+
+#ifndef OH_LATENCY_BUCKETS
+#define OH_LATENCY_BUCKETS 21  ///< Number of buckets, the last one also counts everything above 2^20 us (about 1 s).
+#endif
+
+#define OH_LATENCY_REPORT 0xFF10  ///< Host writes a non zero value to the service channel to get a report from every latency probe.
+#define OH_LATENCY_CLEAR 0xFF12   ///< Host writes a non zero value to the service channel to clear every latency probe.
+
+namespace OpenHornet {
+
+/**
+ * @class LatencyHistogram
+ * @brief Counts latencies in power of two buckets.
+ */
+class LatencyHistogram {
+private:
+    unsigned int buckets_[OH_LATENCY_BUCKETS];  ///< Number of samples per bucket, stops counting at 65535.
+    unsigned int count_;                        ///< Number of samples, stops counting at 65535.
+    unsigned long min_;                         ///< Smallest sample.
+    unsigned long max_;                         ///< Largest sample.
+
+    /**
+     * @return The bucket of a sample.
+     */
+    static byte bucketOf(unsigned long micros) {
+        byte bucket = 0;
+        while (micros > 1 && bucket < OH_LATENCY_BUCKETS - 1) {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+public:
+    LatencyHistogram() {
+        clear();
+    }
+
+    /**
+     * Forgets all samples.
+     */
+    void clear() {
+        for (byte i = 0; i < OH_LATENCY_BUCKETS; i++) {
+            buckets_[i] = 0;
+        }
+        count_ = 0;
+        min_ = 0xFFFFFFFFUL;
+        max_ = 0;
+    }
+
+    /**
+     * Adds a sample.
+     * @param micros The latency in microseconds.
+     */
+    void add(unsigned long micros) {
+        byte bucket = bucketOf(micros);
+        if (buckets_[bucket] < 0xFFFF) {
+            buckets_[bucket]++;
+        }
+        if (count_ < 0xFFFF) {
+            count_++;
+        }
+        if (micros < min_) {
+            min_ = micros;
+        }
+        if (micros > max_) {
+            max_ = micros;
+        }
+    }
+
+    /**
+     * @return The number of samples.
+     */
+    unsigned int count() {
+        return count_;
+    }
+
+    /**
+     * @return The smallest sample, 0 without samples.
+     */
+    unsigned long minimum() {
+        return (count_ == 0) ? 0 : min_;
+    }
+
+    /**
+     * @return The largest sample.
+     */
+    unsigned long maximum() {
+        return max_;
+    }
+
+    /**
+     * Estimates a percentile.
+     * @param percent The percentile, 1 to 100. 50 gives the median.
+     * @return The latency that percent of the samples are at or below, in microseconds. 0 without samples.
+     */
+    unsigned long percentile(byte percent) {
+        unsigned long total = 0;
+        for (byte i = 0; i < OH_LATENCY_BUCKETS; i++) {
+            total += buckets_[i];
+        }
+        if (total == 0) {
+            return 0;
+        }
+
+        unsigned long rank = (total * percent + 99) / 100;  // Rounded up, the 50th of 3 samples is the 2nd.
+        if (rank == 0) {
+            rank = 1;
+        }
+        for (byte i = 0; i < OH_LATENCY_BUCKETS; i++) {
+            if (rank <= buckets_[i]) {
+                // Interpolate between the bucket's limits, narrowed to the samples actually seen.
+                unsigned long low = max((i == 0) ? 0UL : (1UL << i), min_);
+                unsigned long high = (i == OH_LATENCY_BUCKETS - 1) ? max_ : min((2UL << i) - 1, max_);
+                return low + ((high - low) / buckets_[i]) * rank;
+            }
+            rank -= buckets_[i];
+        }
+        return max_;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
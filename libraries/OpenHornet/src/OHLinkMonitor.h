@@ -0,0 +1,247 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHLinkMonitor.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Notices when the export stream stops and comes back, and brings host and panel back in step.
+ *
+ * DCS-BIOS ends every export frame with the frame counter at 0xFFFE, so a panel that gets no frame counter for
+ * OH_LINK_TIMEOUT_MS has lost its link (USB cable bumped, host bridge restarted, DCS paused). While the link is down,
+ * switch moves on the panel are lost and so are the changes in the sim. When frames arrive again the monitor:
+ *
+ * -# resets the state of every DCS-BIOS input, so every switch sends its position again on the next poll;
+ * -# sends `OH_RESYNC <outage in ms> <reconnects>`, so a host bridge that keeps a snapshot of the export data
+ *    can replay it right away instead of waiting for the next changes.
+ *
+ * The outage time tells how long reattaching took from the panel's point of view.
+ *
+ * The monitor also keeps the time between frames, to show how evenly the host bridge forwards them. It averages
+ * the frame period over the last OH_FRAME_PERIOD_AVERAGE frames or so, and once that many frames came in, puts how
+ * far each frame is off that period into a histogram. The histogram buckets double in size, so a period of 33 ms would hide a few ms of
+ * jitter, while the deviation starts at 0 and lands in 1, 2, 4 and 8 ms buckets. A write to OH_LATENCY_REPORT
+ * makes it reply
+ *
+ *     OH_FRAMES <count> <period> <p50> <p99> <max>
+ *
+ * in microseconds, next to the latency probes: the average period, then the deviation from it. The time is taken
+ * when the panel handles the frame counter, so it includes the panel's own loop time: compare host settings on
+ * the same panel. A write to OH_LATENCY_CLEAR starts over.
+ */
+
+#ifndef OH_LINK_MONITOR_H
+#define OH_LINK_MONITOR_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+#include "OHLatencyHistogram.h"
+
+#ifndef OH_LINK_TIMEOUT_MS
+#define OH_LINK_TIMEOUT_MS 500  ///< Without a frame for this long, the link counts as lost. DCS-BIOS sends 30 frames per second.
+#endif
+
+#ifndef OH_FRAME_PERIOD_AVERAGE
+#define OH_FRAME_PERIOD_AVERAGE 16  ///< Each frame moves the average period by 1/16 of its difference, a power of two.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class LinkMonitor
+ * @brief Watches the DCS-BIOS frame counter.
+ */
+class LinkMonitor : public ServiceHandler, public DcsBios::ExportStreamListener {
+private:
+    unsigned long lastFrameMs_;           ///< millis() of the last frame counter.
+    bool connected_;                      ///< True while frames arrive.
+    bool everConnected_;                  ///< True once the first frame arrived.
+    unsigned long lostMs_;                ///< millis() when the link was lost.
+    unsigned long lastOutageMs_;          ///< Length of the last outage.
+    unsigned int reconnects_;             ///< Number of times the link came back.
+    bool resyncPending_;                  ///< True while OH_RESYNC still has to be sent.
+    unsigned long lastFrameMicros_;       ///< micros() of the last frame counter.
+    long periodMicros_;                   ///< Average time between frames.
+    byte periodFrames_;                   ///< Frames averaged so far, up to OH_FRAME_PERIOD_AVERAGE.
+    bool reportPending_;                  ///< True while OH_FRAMES still has to be sent.
+    LatencyHistogram jitter_;             ///< How far each frame was off the average period.
+
+    /**
+     * Updates the average period with the time since the last frame and records how far that was off.
+     * @param interval Time since the last frame in us.
+     */
+    void addInterval(unsigned long interval) {
+        long deviation = (long)interval - periodMicros_;
+        if (periodFrames_ < OH_FRAME_PERIOD_AVERAGE) {
+            periodFrames_++;  // Plain average of the first frames, the jitter is not measured yet.
+            periodMicros_ += deviation / periodFrames_;
+            return;
+        }
+        jitter_.add(abs(deviation));
+        periodMicros_ += deviation / OH_FRAME_PERIOD_AVERAGE;
+    }
+
+public:
+    /**
+     * Subscribes to the frame counter.
+     */
+    LinkMonitor() : DcsBios::ExportStreamListener(0xFFFE, 0xFFFE) {
+        lastFrameMs_ = 0;
+        connected_ = false;
+        everConnected_ = false;
+        lostMs_ = 0;
+        lastOutageMs_ = 0;
+        reconnects_ = 0;
+        resyncPending_ = false;
+        lastFrameMicros_ = 0;
+        periodMicros_ = 0;
+        periodFrames_ = 0;
+        reportPending_ = false;
+    }
+
+    /**
+     * Notes the time of every frame and how evenly it followed the last one. Gaps of an outage are not counted.
+     * @param address Export address that was written.
+     * @param value The frame counter.
+     */
+    virtual void onDcsBiosWrite(unsigned int address, unsigned int value) {
+        unsigned long now = millis();
+        unsigned long nowMicros = micros();
+        if (lastFrameMs_ != 0 && (now - lastFrameMs_) < OH_LINK_TIMEOUT_MS) {
+            addInterval(nowMicros - lastFrameMicros_);
+        }
+        lastFrameMs_ = now;
+        lastFrameMicros_ = nowMicros;
+    }
+
+    /**
+     * Stores report and clear requests from the host.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        if (value == 0) {
+            return;
+        }
+        if (address == OH_LATENCY_REPORT) {
+            reportPending_ = true;
+        } else if (address == OH_LATENCY_CLEAR) {
+            jitter_.clear();
+            periodMicros_ = 0;
+            periodFrames_ = 0;
+        }
+    }
+
+    /**
+     * Checks the link, brings the inputs back in step after an outage and sends OH_RESYNC and OH_FRAMES.
+     */
+    virtual void serviceLoop() {
+        unsigned long now = millis();
+        bool framesArrive = lastFrameMs_ != 0 && (now - lastFrameMs_) < OH_LINK_TIMEOUT_MS;
+
+        if (connected_ == true && framesArrive == false) {
+            connected_ = false;
+            lostMs_ = lastFrameMs_;
+        } else if (connected_ == false && framesArrive == true) {
+            connected_ = true;
+            if (everConnected_ == true) {
+                lastOutageMs_ = now - lostMs_;
+                reconnects_++;
+                DcsBios::resetAllStates();
+                resyncPending_ = true;
+            }
+            everConnected_ = true;
+        }
+
+        if (resyncPending_ == true) {
+            ServiceReply reply;
+            reply.addNumber(lastOutageMs_);
+            reply.addNumber(reconnects_);
+            if (reply.send("OH_RESYNC")) {
+                resyncPending_ = false;
+            }
+        }
+
+        if (reportPending_ == true) {
+            ServiceReply reply;
+            reply.addNumber(jitter_.count());
+            reply.addNumber(periodMicros_);
+            reply.addNumber(jitter_.percentile(50));
+            reply.addNumber(jitter_.percentile(99));
+            reply.addNumber(jitter_.maximum());
+            if (reply.send("OH_FRAMES")) {
+                reportPending_ = false;
+            }
+        }
+    }
+
+    /**
+     * @return How far the frames were off the average period.
+     */
+    LatencyHistogram& frameJitter() {
+        return jitter_;
+    }
+
+    /**
+     * @return Average time between frames in us, 0 before the second frame.
+     */
+    unsigned long framePeriodMicros() {
+        return periodMicros_;
+    }
+
+    /**
+     * @return True while export frames arrive.
+     */
+    bool isConnected() {
+        return connected_;
+    }
+
+    /**
+     * @return Length of the last outage in ms, 0 if the link was never lost.
+     */
+    unsigned long lastOutageMs() {
+        return lastOutageMs_;
+    }
+
+    /**
+     * @return Number of times the link came back.
+     */
+    unsigned int reconnects() {
+        return reconnects_;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
@@ -0,0 +1,70 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHListenerRanges.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Reads the export address ranges a sketch listens to from the DCS-BIOS listener list.
+ *
+ * Every DCS-BIOS output (IntegerBuffer, StringBuffer, LED, ...) is an ExportStreamListener, and the listeners are kept
+ * in one list sorted by their first address. Walking that list gives the sketch's subscriptions without any table.
+ */
+
+#ifndef OH_LISTENER_RANGES_H
+#define OH_LISTENER_RANGES_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+
+namespace OpenHornet {
+
+/**
+ * Reads the next address range from the listener list. Overlapping and neighbouring listeners are merged.
+ * @param listener The first listener of the range, moved past the last listener of the range.
+ * @param first First address of the range.
+ * @param last Last address of the range.
+ */
+void nextListenerRange(DcsBios::ExportStreamListener*& listener, unsigned int& first, unsigned int& last) {
+    first = listener->getFirstAddressOfInterest();
+    last = listener->getLastAddressOfInterest();
+    listener = listener->nextExportStreamListener;
+    while (listener != NULL && listener->getFirstAddressOfInterest() <= last + 2) {
+        last = max(last, listener->getLastAddressOfInterest());
+        listener = listener->nextExportStreamListener;
+    }
+}
+
+}  // namespace OpenHornet
+
+#endif
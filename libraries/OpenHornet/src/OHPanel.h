@@ -0,0 +1,88 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHPanel.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief The OpenHornet services that every panel sketch runs next to DCS-BIOS.
+ *
+ * Include this file after DcsBios.h and call OpenHornet::serviceLoop() right after DcsBios::loop().
+ * It sets up the service channel (see OHService.h) and the following services:
+ *
+ * - **Time sync:** OpenHornet::timeSync keeps a microsecond clock aligned to the host, see OHTimeSync.h.
+ * - **Identity:** OpenHornet::identity tells the host the sketch, build, board and subscribed addresses, see OHIdentity.h.
+ * - **Link monitor:** OpenHornet::linkMonitor re-sends every input after the export stream was lost, see OHLinkMonitor.h.
+ * - **Analog inputs:** sketches may use OpenHornet::CoalescedPotentiometer for knobs that are swept, see OHAnalogInput.h.
+ * - **Dimmers:** a DimmerPublisher sends a dimmer knob to the host, and a PredictedDimmer lets a backlight follow it
+ *   before the sim does, see OHDimmer.h.
+ * - **Input state:** OpenHornet::inputDump tells the host the position of every OpenHornet::ReportedInput and makes
+ *   single inputs send again, see OHInputState.h.
+ * - **Echo latency:** sketches may declare an OpenHornet::EchoLatencyProbe per switch, see OHEchoLatency.h.
+ * - **Actuator latency:** sketches may declare an OpenHornet::ActuatorLatencyProbe per output, see OHActuatorLatency.h.
+ * - **Debounce tuning:** sketches may take their debounce delays from an OpenHornet::DebounceTuner, see OHDebounceTuner.h.
+ *
+ * With OH_ISR_EXPORT_PARSER defined instead of DCSBIOS_IRQ_SERIAL, it also brings in the interrupt driven export parser
+ * (see OHIsrExportParser.h). With OH_BATCHED_SERIAL defined instead of DCSBIOS_DEFAULT_SERIAL, it brings in the batched
+ * command backend (see OHBatchedSerial.h). With OH_IRQ_PROFILER defined on an AVR board, it measures how long
+ * interrupts have to wait (see OHIrqProfiler.h).
+ */
+
+#ifndef OH_PANEL_H
+#define OH_PANEL_H
+
+#include "DcsBios.h"
+#include "OHIsrExportParser.h"
+#include "OHService.h"
+#include "OHBatchedSerial.h"
+#include "OHTimeSync.h"
+#include "OHLinkMonitor.h"
+#include "OHIdentity.h"
+#include "OHInputState.h"
+#include "OHAnalogInput.h"
+#include "OHDimmer.h"
+#include "OHEchoLatency.h"
+#include "OHActuatorLatency.h"
+#include "OHDebounceTuner.h"
+#include "OHIrqProfiler.h"
+
+namespace OpenHornet {
+
+TimeSync timeSync;        ///< Host aligned clock of this panel.
+LinkMonitor linkMonitor;  ///< Watches the export stream for outages.
+Identity identity;        ///< Answers the host's identify request.
+InputDump inputDump;      ///< Answers the host's input dump and resend requests.
+
+}  // namespace OpenHornet
+
+#endif
@@ -0,0 +1,249 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHService.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Service channel between host tools and the panels, carried on the normal DCS-BIOS serial link.
+ *
+ * Host tools (time sync, identification, diagnostics) need to talk to every panel without a second cable.
+ * The service channel reuses both directions of the DCS-BIOS link:
+ *
+ * - **Host to panel:** the host writes 16 bit words to the addresses OH_SERVICE_FIRST_ADDRESS to
+ *   OH_SERVICE_LAST_ADDRESS, using the normal export stream format. DCS-BIOS does not use these addresses,
+ *   the aircraft data ends far below them and the frame counter lives at 0xFFFE.
+ * - **Panel to host:** the panel sends normal command lines whose name starts with `OH_`, for example
+ *   `OH_SYNC 12 4081234 4081302`. DCS ignores commands it does not know.
+ *
+ * Each feature is a ServiceHandler. Handlers get the host's writes while the export stream is parsed and
+ * must only store them; replies are sent from serviceLoop(), which the sketch calls from loop().
+ *
+ * Commands are not sequence numbered. The host repeats a command by writing the same value again, so every write
+ * must reach the handlers, also when the value did not change. Backends that drop unchanged words, like
+ * OHIsrExportParser.h, pass the service channel addresses through.
+ *
+ * ### Address map:
+ * Address         | Use
+ * --------------- | ---
+ * 0xFF00 - 0xFF0E | Time sync, see OHTimeSync.h
+ * 0xFF10 - 0xFF12 | Latency probes, see OHLatencyHistogram.h
+ * 0xFF14          | Identify, see OHIdentity.h
+ * 0xFF16          | Transmit counters, see OHBatchedSerial.h
+ * 0xFF18          | Debounce calibration, see OHDebounceTuner.h
+ * 0xFF1A - 0xFF1C | Input state dump and resend, see OHInputState.h
+ * 0xFF1E - 0xFF24 | Relayed dimmer channels, see OHDimmer.h
+ * 0xFF26          | Replay control of the COMMAND_REPLAY benchmark
+ * 0xFF28 - 0xFF3E | Reserved for later services
+ */
+
+#ifndef OH_SERVICE_H
+#define OH_SERVICE_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+
+#define OH_SERVICE_FIRST_ADDRESS 0xFF00  ///< First export address of the service channel.
+#define OH_SERVICE_LAST_ADDRESS 0xFF3E   ///< Last export address of the service channel.
+
+#ifndef OH_SERVICE_REPLY_LENGTH
+#define OH_SERVICE_REPLY_LENGTH 48  ///< Longest reply argument in characters, the buffer lives on the stack only while a reply is built.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class ServiceHandler
+ * @brief Base class of every feature that uses the service channel.
+ *
+ * Creating a handler links it into the list that the service channel serves.
+ */
+class ServiceHandler {
+private:
+    ServiceHandler* nextHandler_;  ///< Next handler in the list.
+
+public:
+    static ServiceHandler* firstHandler;  ///< Start of the list of handlers.
+
+    /**
+     * Links the new handler into the list.
+     */
+    ServiceHandler() {
+        nextHandler_ = firstHandler;
+        firstHandler = this;
+    }
+
+    /**
+     * Called for every host write to the service channel, while the export stream is parsed.
+     * Only store what is needed, do not send from here.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {}
+
+    /**
+     * Called from serviceLoop(), send pending replies here.
+     */
+    virtual void serviceLoop() {}
+
+    /**
+     * @return The next handler in the list, or NULL.
+     */
+    ServiceHandler* next() {
+        return nextHandler_;
+    }
+};
+
+ServiceHandler* ServiceHandler::firstHandler = NULL;
+
+/**
+ * @class ServiceChannel
+ * @brief Listens to the service addresses in the export stream and hands every write to the handlers.
+ */
+class ServiceChannel : public DcsBios::ExportStreamListener {
+public:
+    /**
+     * Subscribes to the whole service address range.
+     */
+    ServiceChannel() : DcsBios::ExportStreamListener(OH_SERVICE_FIRST_ADDRESS, OH_SERVICE_LAST_ADDRESS) {}
+
+    /**
+     * Hands a host write to every handler.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onDcsBiosWrite(unsigned int address, unsigned int value) {
+        for (ServiceHandler* handler = ServiceHandler::firstHandler; handler != NULL; handler = handler->next()) {
+            handler->onServiceWrite(address, value);
+        }
+    }
+};
+
+ServiceChannel serviceChannel;  ///< The one service channel of the sketch.
+
+/**
+ * Lets every service handler send its pending replies. Call it from loop(), right after DcsBios::loop().
+ */
+void serviceLoop() {
+    for (ServiceHandler* handler = ServiceHandler::firstHandler; handler != NULL; handler = handler->next()) {
+        handler->serviceLoop();
+    }
+}
+
+/**
+ * @class ServiceReply
+ * @brief Builds the argument of a reply from numbers and text, separated by spaces.
+ *
+ * Text that does not fit into OH_SERVICE_REPLY_LENGTH is cut off.
+ */
+class ServiceReply {
+private:
+    char text_[OH_SERVICE_REPLY_LENGTH + 1];  ///< The argument built so far.
+    byte length_;                             ///< Number of characters in text_.
+
+public:
+    ServiceReply() {
+        length_ = 0;
+        text_[0] = '\0';
+    }
+
+    /**
+     * Adds a word to the reply, with a space before it unless it is the first one.
+     * @param word The text to add.
+     */
+    void addText(const char* word) {
+        if (length_ > 0 && length_ < OH_SERVICE_REPLY_LENGTH) {
+            text_[length_++] = ' ';
+        }
+        while (*word != '\0' && length_ < OH_SERVICE_REPLY_LENGTH) {
+            text_[length_++] = *word++;
+        }
+        text_[length_] = '\0';
+    }
+
+    /**
+     * Adds a word that is stored in flash (PROGMEM) to the reply.
+     * @param word The text to add.
+     */
+    void addText_P(const char* word) {
+        if (length_ > 0 && length_ < OH_SERVICE_REPLY_LENGTH) {
+            text_[length_++] = ' ';
+        }
+        char c;
+        while ((c = pgm_read_byte(word++)) != '\0' && length_ < OH_SERVICE_REPLY_LENGTH) {
+            text_[length_++] = c;
+        }
+        text_[length_] = '\0';
+    }
+
+    /**
+     * Adds an unsigned number to the reply.
+     * @param value The number to add.
+     * @param base 10 for decimal, 16 for hexadecimal.
+     */
+    void addNumber(unsigned long value, byte base = 10) {
+        char buf[11];
+        ultoa(value, buf, base);
+        addText(buf);
+    }
+
+    /**
+     * Adds a signed number to the reply.
+     * @param value The number to add.
+     */
+    void addSigned(long value) {
+        char buf[12];
+        ltoa(value, buf, 10);
+        addText(buf);
+    }
+
+    /**
+     * @return The argument built so far.
+     */
+    const char* text() {
+        return text_;
+    }
+
+    /**
+     * Sends the reply as a DCS-BIOS command line.
+     * @param msg Name of the reply, starting with `OH_`.
+     * @return True if the message was sent or queued.
+     */
+    bool send(const char* msg) {
+        return DcsBios::tryToSendDcsBiosMessage(msg, text_);
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
@@ -0,0 +1,416 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHShiftRegisterInput.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Reads a chain of 74HC165 parallel-in shift registers with the hardware SPI peripheral.
+ *
+ * Big panels (caution lights, UFC, armament) have more switches than a Pro Micro has pins.
+ * A chain of 74HC165 chips turns 8 switches per chip into one serial stream, which the SPI peripheral
+ * clocks in one byte at a time. Reading 64 inputs takes a few microseconds, compared to a few hundred
+ * microseconds for 64 calls to digitalRead().
+ *
+ * Each input on the chain is a "virtual pin". Virtual pin 0 is input D0 of the chip closest to the Arduino,
+ * virtual pin 8 is input D0 of the second chip, and so on. The switch classes in this file work like the
+ * DCS-BIOS Switch2Pos, Switch3Pos and SwitchMultiPos classes, but take virtual pins instead of Arduino pins.
+ * Like those they are DcsBios::PollingInput objects: DcsBios::loop() polls them, and DcsBios::resetAllStates()
+ * makes them send their position again. The sketch only has to call scan() on the chain right before
+ * DcsBios::loop(), so the switches read a fresh snapshot:
+ *
+ *     void loop() {
+ *       srChain.scan();
+ *       DcsBios::loop();
+ *     }
+ *
+ * ### Wiring:
+ * 74HC165 | Arduino
+ * ------- | ---
+ * PL      | Any digital pin (the load pin)
+ * CP      | SCK
+ * QH      | MISO (QH of the last chip feeds DS of the previous one)
+ * CE      | GND
+ *
+ * Every 74HC165 input needs a pull-up resistor, switches close to GND like on the ABSIS ALE.
+ *
+ * @attention On the Pro Micro the SPI pins are 14 (MISO), 15 (SCK) and 16 (MOSI). A panel that uses a shift register chain
+ * can not use these pins for switches. MOSI is not used by the chain but is still driven by the SPI peripheral.
+ * @attention The 74HC165 does not release QH, so it can not share MISO with another SPI device without a buffer.
+ */
+
+#ifndef OH_SHIFT_REGISTER_INPUT_H
+#define OH_SHIFT_REGISTER_INPUT_H
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "DcsBios.h"
+
+#ifndef OH_SR_MAX_CHIPS
+#define OH_SR_MAX_CHIPS 16  ///< Largest supported chain (128 inputs). Define before including this file to change it.
+#endif
+
+#ifndef OH_SR_SPI_CLOCK
+#define OH_SR_SPI_CLOCK 4000000  ///< SPI clock in Hz. 4 MHz leaves margin for long ribbon cables between the boards.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class ShiftRegisterChain
+ * @brief A chain of 74HC165 shift registers read through the hardware SPI peripheral.
+ *
+ * Call scan() once per loop, right before DcsBios::loop() polls the switches on the chain. The switches read the
+ * snapshot taken by scan(), so all inputs on the chain are sampled at the same moment.
+ */
+class ShiftRegisterChain {
+private:
+    byte loadPin_;                     ///< Arduino pin connected to PL (parallel load) on every chip.
+    byte numberOfChips_;               ///< Number of 74HC165 chips in the chain.
+    byte inputs_[OH_SR_MAX_CHIPS];     ///< Snapshot of all inputs, one byte per chip.
+    SPISettings spiSettings_;          ///< SPI clock, bit order and mode for the 74HC165.
+#ifdef __AVR__
+    volatile uint8_t* loadPort_;       ///< Output register of the load pin, for a fast load pulse.
+    uint8_t loadBitMask_;              ///< Bit of the load pin in its output register.
+#endif
+
+    /**
+     * Pulses the load pin LOW, which copies the state of all inputs into the shift registers.
+     * On AVR the port register is written directly, digitalWrite() would take longer than the whole SPI transfer.
+     */
+    void pulseLoad() {
+#ifdef __AVR__
+        uint8_t oldSREG = SREG;
+        cli();
+        *loadPort_ &= ~loadBitMask_;
+        *loadPort_ |= loadBitMask_;
+        SREG = oldSREG;
+#else
+        digitalWrite(loadPin_, LOW);
+        digitalWrite(loadPin_, HIGH);
+#endif
+    }
+
+public:
+    /**
+     * Constructor for a shift register chain.
+     * @param loadPin Arduino pin connected to PL on every chip.
+     * @param numberOfChips Number of 74HC165 chips in the chain, up to OH_SR_MAX_CHIPS.
+     * @param spiClock SPI clock in Hz.
+     */
+    ShiftRegisterChain(byte loadPin, byte numberOfChips, unsigned long spiClock = OH_SR_SPI_CLOCK)
+        : spiSettings_(spiClock, MSBFIRST, SPI_MODE2) {
+        loadPin_ = loadPin;
+        numberOfChips_ = (numberOfChips > OH_SR_MAX_CHIPS) ? OH_SR_MAX_CHIPS : numberOfChips;
+        for (byte i = 0; i < OH_SR_MAX_CHIPS; i++) {
+            inputs_[i] = 0xFF;  // All switches open until the first scan.
+        }
+    }
+
+    /**
+     * Sets up the load pin and the SPI peripheral, then takes the first snapshot.
+     * Call this in setup() before DcsBios::setup(), so the switches start from the real positions.
+     */
+    void begin() {
+        pinMode(loadPin_, OUTPUT);
+        digitalWrite(loadPin_, HIGH);
+#ifdef __AVR__
+        loadPort_ = portOutputRegister(digitalPinToPort(loadPin_));
+        loadBitMask_ = digitalPinToBitMask(loadPin_);
+#endif
+        SPI.begin();
+        scan();
+    }
+
+    /**
+     * Reads all inputs of the chain into the snapshot.
+     * The first byte clocked in belongs to the chip closest to the Arduino.
+     */
+    void scan() {
+        // Set the mode before loading. SCK idles low after SPI.begin() or a mode 0 device, and the rising
+        // edge of the switch to mode 2 would shift the freshly loaded chain by one bit.
+        SPI.beginTransaction(spiSettings_);
+        pulseLoad();
+        for (byte i = 0; i < numberOfChips_; i++) {
+            inputs_[i] = SPI.transfer(0);
+        }
+        SPI.endTransaction();
+    }
+
+    /**
+     * Reads one input from the last snapshot.
+     * @param virtualPin Input number on the chain, 8 per chip starting at 0.
+     * @return HIGH or LOW, like digitalRead(). Inputs past the end of the chain read HIGH (open).
+     */
+    byte readPin(byte virtualPin) {
+        byte chip = virtualPin / 8;
+        if (chip >= numberOfChips_) {
+            return HIGH;
+        }
+        return (inputs_[chip] >> (virtualPin % 8)) & 1;
+    }
+
+    /**
+     * @return The number of inputs on the chain.
+     */
+    unsigned int numberOfInputs() {
+        return numberOfChips_ * 8;
+    }
+};
+
+/**
+ * @class ShiftRegisterSwitch
+ * @brief Debounce and send logic shared by the shift register switch classes.
+ *
+ * Works like the debounce logic in the DCS-BIOS switch classes: a new position is sent once it has been
+ * steady for the debounce delay. If the message can not be sent, it is tried again on the next poll.
+ * Polled by DcsBios::loop() like every DcsBios::PollingInput.
+ */
+class ShiftRegisterSwitch : DcsBios::PollingInput {
+private:
+    /**
+     * Forces the switch to send its position on the next poll, called by DcsBios::resetAllStates().
+     */
+    void resetState() {
+        lastState_ = (lastState_ == 0) ? -1 : 0;
+    }
+
+    /**
+     * Checks the switch position and sends it to DCS once it is steady for the debounce delay.
+     */
+    void pollInput() {
+        char state = readState();
+
+        unsigned long now = millis();
+        if (state != debounceSteadyState_) {
+            lastDebounceTime_ = now;
+            debounceSteadyState_ = state;
+        }
+        if ((now - lastDebounceTime_) >= debounceDelay_) {
+            if (state != lastState_) {
+                char buf[7];
+                utoa(state, buf, 10);
+                if (DcsBios::tryToSendDcsBiosMessage(msg_, buf)) {
+                    lastState_ = state;
+                }
+            }
+        }
+    }
+
+protected:
+    ShiftRegisterChain& chain_;         ///< The chain the switch is connected to.
+    const char* msg_;                   ///< The DCS BIOS message associated with the switch.
+    char lastState_;                    ///< Last position sent to DCS.
+    char debounceSteadyState_;          ///< The current steady state used for debounce comparison.
+    unsigned long debounceDelay_;       ///< Delay in milliseconds to consider the switch stable.
+    unsigned long lastDebounceTime_;    ///< Timestamp of the last change of the switch position.
+
+    /**
+     * Reads the current position of the switch from the chain snapshot.
+     * @return The position number that is sent to DCS.
+     */
+    virtual char readState() = 0;
+
+    /**
+     * Initializes the switch state from the current snapshot. Called by the constructor of each switch class.
+     */
+    void initState() {
+        lastState_ = readState();
+        debounceSteadyState_ = lastState_;
+        lastDebounceTime_ = 0;
+    }
+
+public:
+    /**
+     * Constructor for the shared switch logic.
+     * @param msg The DCS BIOS message identifier associated with this switch.
+     * @param chain The shift register chain the switch is connected to.
+     * @param debounceDelay Debounce time in milliseconds.
+     */
+    ShiftRegisterSwitch(const char* msg, ShiftRegisterChain& chain, unsigned long debounceDelay)
+        : DcsBios::PollingInput(POLL_EVERY_TIME), chain_(chain) {
+        msg_ = msg;
+        debounceDelay_ = debounceDelay;
+    }
+
+    /**
+     * Sets or changes the DCS BIOS message for the switch control.
+     * @param msg New DCS BIOS message identifier for the switch.
+     */
+    void SetControl(const char* msg) {
+        msg_ = msg;
+    }
+
+    /**
+     * Forces the switch to send its position on the next poll.
+     */
+    void resetThisState() {
+        this->resetState();
+    }
+
+    /**
+     * Polls the switch right away, as the DCS-BIOS switch classes allow. DcsBios::loop() already polls it.
+     */
+    void pollThisInput() {
+        this->pollInput();
+    }
+};
+
+/**
+ * @class ShiftRegisterSwitch2Pos
+ * @brief Two position switch on a shift register chain, works like DcsBios::Switch2Pos.
+ */
+class ShiftRegisterSwitch2Pos : public ShiftRegisterSwitch {
+private:
+    byte virtualPin_;  ///< Input number on the chain.
+    bool reverse_;     ///< Flag to reverse the reading logic (HIGH/LOW).
+
+    /**
+     * @return 1 when the switch is closed to GND, 0 when it is open (reversed if requested).
+     */
+    char readState() {
+        byte level = chain_.readPin(virtualPin_);
+        if (reverse_ == true) {
+            return (level == HIGH) ? 1 : 0;
+        }
+        return (level == LOW) ? 1 : 0;
+    }
+
+public:
+    /**
+     * Constructor for a two position switch on the chain.
+     * @param msg The DCS BIOS message identifier associated with this switch.
+     * @param chain The shift register chain the switch is connected to.
+     * @param virtualPin Input number on the chain.
+     * @param reverse Set to true to reverse the reading logic (for normally closed switches).
+     * @param debounceDelay Debounce time in milliseconds.
+     */
+    ShiftRegisterSwitch2Pos(const char* msg, ShiftRegisterChain& chain, byte virtualPin, bool reverse = false, unsigned long debounceDelay = 50)
+        : ShiftRegisterSwitch(msg, chain, debounceDelay) {
+        virtualPin_ = virtualPin;
+        reverse_ = reverse;
+        initState();
+    }
+};
+
+/**
+ * @class ShiftRegisterSwitch3Pos
+ * @brief Three position switch on a shift register chain, works like DcsBios::Switch3Pos.
+ */
+class ShiftRegisterSwitch3Pos : public ShiftRegisterSwitch {
+private:
+    byte virtualPinA_;  ///< Input for position 0.
+    byte virtualPinB_;  ///< Input for position 2.
+
+    /**
+     * @return 0 when input A is closed, 2 when input B is closed, 1 (middle) otherwise.
+     */
+    char readState() {
+        if (chain_.readPin(virtualPinA_) == LOW) {
+            return 0;
+        }
+        if (chain_.readPin(virtualPinB_) == LOW) {
+            return 2;
+        }
+        return 1;
+    }
+
+public:
+    /**
+     * Constructor for a three position switch on the chain.
+     * @param msg The DCS BIOS message identifier associated with this switch.
+     * @param chain The shift register chain the switch is connected to.
+     * @param virtualPinA Input number on the chain for position 0.
+     * @param virtualPinB Input number on the chain for position 2.
+     * @param debounceDelay Debounce time in milliseconds.
+     */
+    ShiftRegisterSwitch3Pos(const char* msg, ShiftRegisterChain& chain, byte virtualPinA, byte virtualPinB, unsigned long debounceDelay = 50)
+        : ShiftRegisterSwitch(msg, chain, debounceDelay) {
+        virtualPinA_ = virtualPinA;
+        virtualPinB_ = virtualPinB;
+        initState();
+    }
+};
+
+/**
+ * @class ShiftRegisterSwitchMultiPos
+ * @brief Multi position (rotary) switch on a shift register chain, works like DcsBios::SwitchMultiPos.
+ *
+ * Use DcsBios::PIN_NC for a position that has no input, that position is selected when no other input is closed.
+ */
+class ShiftRegisterSwitchMultiPos : public ShiftRegisterSwitch {
+private:
+    const byte* virtualPins_;  ///< Array of input numbers on the chain, one per position.
+    char numberOfPins_;        ///< Total number of positions of the switch.
+    bool reverse_;             ///< Flag to reverse the reading logic (HIGH/LOW).
+
+    /**
+     * @return The first position whose input is closed, the unconnected position, or the last position if none is closed.
+     */
+    char readState() {
+        char ncPinIdx = lastState_;
+        for (unsigned char i = 0; i < numberOfPins_; i++) {
+            if (virtualPins_[i] == DcsBios::PIN_NC) {
+                ncPinIdx = i;
+            } else {
+                byte level = chain_.readPin(virtualPins_[i]);
+                if (level == LOW && reverse_ == false) return i;
+                if (level == HIGH && reverse_ == true) return i;
+            }
+        }
+        return ncPinIdx;
+    }
+
+public:
+    /**
+     * Constructor for a multi position switch on the chain.
+     * @param msg The DCS BIOS message identifier associated with this switch.
+     * @param chain The shift register chain the switch is connected to.
+     * @param virtualPins Array of input numbers on the chain, one per position.
+     * @param numberOfPins Number of positions on the switch.
+     * @param reverse Set to true to reverse the reading logic (for normally closed switches).
+     * @param debounceDelay Debounce time in milliseconds.
+     */
+    ShiftRegisterSwitchMultiPos(const char* msg, ShiftRegisterChain& chain, const byte* virtualPins, char numberOfPins, bool reverse = false, unsigned long debounceDelay = 50)
+        : ShiftRegisterSwitch(msg, chain, debounceDelay) {
+        virtualPins_ = virtualPins;
+        numberOfPins_ = numberOfPins;
+        reverse_ = reverse;
+        lastState_ = 0;
+        initState();
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif
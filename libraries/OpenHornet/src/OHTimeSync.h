@@ -0,0 +1,243 @@
+/**************************************************************************************
+ *        ____                   _    _                       _
+ *       / __ \                 | |  | |                     | |
+ *      | |  | |_ __   ___ _ __ | |__| | ___  _ __ _ __   ___| |_
+ *      | |  | | '_ \ / _ \ '_ \|  __  |/ _ \| '__| '_ \ / _ \ __|
+ *      | |__| | |_) |  __/ | | | |  | | (_) | |  | | | |  __/ |_
+ *       \____/| .__/ \___|_| |_|_|  |_|\___/|_|  |_| |_|\___|\__|
+ *             | |
+ *             |_|
+ *   ----------------------------------------------------------------------------------
+ *   Copyright 2016-2024 OpenHornet
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *   ----------------------------------------------------------------------------------
+ *   Note: All other portions of OpenHornet not within the 'OpenHornet-Software'
+ *   GitHub repository is released under the Creative Commons Attribution -
+ *   Non-Commercial - Share Alike License. (CC BY-NC-SA 4.0)
+ *   ----------------------------------------------------------------------------------
+ *   This Project uses Doxygen as a documentation generator.
+ *   Please use Doxygen capable comments.
+ **************************************************************************************/
+
+/**
+ * @file OHTimeSync.h
+ * @author OH Community
+ * @date 10.18.2026
+ *
+ * @brief Gives a panel a microsecond clock aligned to the host, with a known error bound.
+ *
+ * Every panel has its own micros() counter, started at a different moment and running at a slightly different rate.
+ * To line up events from several panels (gear lever on 4A2A1, then the LTD/R mag-switch release on 5A7A1),
+ * all of them need the same time base. The host provides it with a short exchange over the service channel:
+ *
+ * -# The host notes its time T1 and writes a sequence number to OH_TIME_SYNC_REQUEST.
+ * -# The panel notes T2 when it parses the write and replies `OH_SYNC <sequence> <T2> <T3>`, T3 being its time when the reply is sent.
+ * -# The host notes T4 when the reply arrives. The round trip delay is (T4 - T1) - (T3 - T2), the offset from panel to
+ *    host time is ((T1 - T2) + (T4 - T3)) / 2, and the offset is off by at most half the round trip delay.
+ * -# The host repeats this a few times, keeps the exchange with the shortest round trip and writes its offset
+ *    (OH_TIME_SYNC_OFFSET_LOW, OH_TIME_SYNC_OFFSET_HIGH), the error bound (OH_TIME_SYNC_BOUND) and finally the
+ *    sequence number to OH_TIME_SYNC_COMMIT. The panel only uses the offset once the commit arrives.
+ *
+ * All times are 32 bit microsecond counters that wrap around after about 71 minutes, host tools need to unwrap them.
+ *
+ * The panel's clock drifts against the host between syncs. After two syncs the drift is measured and corrected,
+ * the error bound then grows by OH_TIME_SYNC_DRIFT_PPM. Before that it grows by OH_TIME_SYNC_UNKNOWN_DRIFT_PPM,
+ * which covers the ceramic resonators on some boards.
+ */
+
+#ifndef OH_TIME_SYNC_H
+#define OH_TIME_SYNC_H
+
+#include "Arduino.h"
+#include "DcsBios.h"
+#include "OHService.h"
+
+#define OH_TIME_SYNC_REQUEST 0xFF00      ///< Host writes a sequence number (1 - 65535) to start an exchange.
+#define OH_TIME_SYNC_OFFSET_LOW 0xFF02   ///< Low word of the offset from panel to host time.
+#define OH_TIME_SYNC_OFFSET_HIGH 0xFF04  ///< High word of the offset from panel to host time.
+#define OH_TIME_SYNC_BOUND 0xFF06        ///< Error bound of the offset in microseconds, 65535 or more is sent as 65535.
+#define OH_TIME_SYNC_COMMIT 0xFF08       ///< Host writes the sequence number of the exchange to apply the offset.
+
+#ifndef OH_TIME_SYNC_DRIFT_PPM
+#define OH_TIME_SYNC_DRIFT_PPM 50  ///< Remaining drift once it has been measured, in parts per million.
+#endif
+
+#ifndef OH_TIME_SYNC_UNKNOWN_DRIFT_PPM
+#define OH_TIME_SYNC_UNKNOWN_DRIFT_PPM 5000  ///< Drift before it has been measured, ceramic resonators are good for 0.5 %.
+#endif
+
+#ifndef OH_TIME_SYNC_TIMEOUT_MS
+#define OH_TIME_SYNC_TIMEOUT_MS 120000  ///< Without a new sync for this long, the clock counts as not synced.
+#endif
+
+namespace OpenHornet {
+
+/**
+ * @class TimeSync
+ * @brief Panel side of the time sync exchange.
+ */
+class TimeSync : public ServiceHandler {
+private:
+    unsigned int requestSequence_;    ///< Sequence number of the request waiting for a reply, 0 if none.
+    unsigned long requestMicros_;     ///< Panel time T2 when the request was parsed.
+    unsigned int pendingOffsetLow_;   ///< Low word of the offset, until the commit arrives.
+    unsigned int pendingOffsetHigh_;  ///< High word of the offset, until the commit arrives.
+    unsigned int pendingBound_;       ///< Error bound, until the commit arrives.
+    bool synced_;                     ///< True once an offset was committed.
+    long offset_;                     ///< Offset from panel to host time at syncMicros_.
+    unsigned long syncMicros_;        ///< Panel time of the last commit.
+    unsigned int bound_;              ///< Error bound of offset_ in microseconds.
+    long driftPpm_;                   ///< Measured drift of the host clock against the panel clock.
+    bool driftKnown_;                 ///< True once the drift was measured from two syncs.
+
+    /**
+     * @return Microseconds from the last commit to a panel time, negative for a time stamped before the commit.
+     * The magnitude is capped at the sync timeout so the drift math can not overflow.
+     */
+    long elapsedSinceSync(unsigned long panelMicros) {
+        long elapsed = (long)(panelMicros - syncMicros_);
+        const long cap = (long)OH_TIME_SYNC_TIMEOUT_MS * 1000L;
+        return constrain(elapsed, -cap, cap);
+    }
+
+    /**
+     * Applies the offset that the host just committed and measures the drift against the previous one.
+     */
+    void commit() {
+        unsigned long now = micros();
+        long newOffset = (long)(((unsigned long)pendingOffsetHigh_ << 16) | pendingOffsetLow_);
+
+        if (synced_ == true) {
+            unsigned long elapsedMs = (now - syncMicros_) / 1000UL;
+            if (elapsedMs >= 1000 && elapsedMs <= OH_TIME_SYNC_TIMEOUT_MS) {
+                // Offset change per millisecond is the drift in parts per thousand, times 1000 gives ppm.
+                long change = newOffset - offset_;
+                if (change > -2000000L && change < 2000000L) {  // A bigger change is a restarted host clock, not drift.
+                    driftPpm_ = constrain((change * 1000L) / (long)elapsedMs, -10000L, 10000L);
+                    driftKnown_ = true;
+                }
+            }
+        }
+
+        offset_ = newOffset;
+        syncMicros_ = now;
+        bound_ = pendingBound_;
+        synced_ = true;
+    }
+
+public:
+    TimeSync() {
+        requestSequence_ = 0;
+        requestMicros_ = 0;
+        pendingOffsetLow_ = 0;
+        pendingOffsetHigh_ = 0;
+        pendingBound_ = 0xFFFF;
+        synced_ = false;
+        offset_ = 0;
+        syncMicros_ = 0;
+        bound_ = 0xFFFF;
+        driftPpm_ = 0;
+        driftKnown_ = false;
+    }
+
+    /**
+     * Stores the host's sync request or offset words.
+     * @param address Export address that was written.
+     * @param value The 16 bit value.
+     */
+    virtual void onServiceWrite(unsigned int address, unsigned int value) {
+        switch (address) {
+            case OH_TIME_SYNC_REQUEST:
+                if (value != 0) {
+                    requestMicros_ = micros();  // T2
+                    requestSequence_ = value;
+                }
+                break;
+            case OH_TIME_SYNC_OFFSET_LOW:
+                pendingOffsetLow_ = value;
+                break;
+            case OH_TIME_SYNC_OFFSET_HIGH:
+                pendingOffsetHigh_ = value;
+                break;
+            case OH_TIME_SYNC_BOUND:
+                pendingBound_ = value;
+                break;
+            case OH_TIME_SYNC_COMMIT:
+                if (value != 0) {
+                    commit();
+                }
+                break;
+        }
+    }
+
+    /**
+     * Answers a pending sync request with T2 and T3.
+     */
+    virtual void serviceLoop() {
+        if (requestSequence_ == 0) {
+            return;
+        }
+        ServiceReply reply;
+        reply.addNumber(requestSequence_);
+        reply.addNumber(requestMicros_);
+        reply.addNumber(micros());  // T3, as late as possible.
+        if (reply.send("OH_SYNC")) {
+            requestSequence_ = 0;
+        }
+    }
+
+    /**
+     * @return True if an offset was committed within the sync timeout.
+     */
+    bool isSynced() {
+        return synced_ == true && (micros() - syncMicros_) / 1000UL < OH_TIME_SYNC_TIMEOUT_MS;
+    }
+
+    /**
+     * Converts a panel micros() time to host time.
+     * @param panelMicros A value returned by micros() on this panel, also one taken before the last sync.
+     * @return The same moment on the host's microsecond clock. Equal to panelMicros until the first sync.
+     */
+    unsigned long toHostMicros(unsigned long panelMicros) {
+        if (synced_ == false) {
+            return panelMicros;
+        }
+        long elapsedMs = elapsedSinceSync(panelMicros) / 1000L;
+        long driftCorrection = (elapsedMs * driftPpm_) / 1000L;
+        return panelMicros + (unsigned long)(offset_ + driftCorrection);
+    }
+
+    /**
+     * @return The current time on the host's microsecond clock.
+     */
+    unsigned long hostMicros() {
+        return toHostMicros(micros());
+    }
+
+    /**
+     * @return The largest possible error of hostMicros() right now, in microseconds. 0xFFFFFFFF before the first sync.
+     */
+    unsigned long errorBoundMicros() {
+        if (synced_ == false) {
+            return 0xFFFFFFFFUL;
+        }
+        unsigned long elapsedMs = abs(elapsedSinceSync(micros())) / 1000L;
+        unsigned long ppm = (driftKnown_ == true) ? OH_TIME_SYNC_DRIFT_PPM : OH_TIME_SYNC_UNKNOWN_DRIFT_PPM;
+        return bound_ + (elapsedMs * ppm) / 1000UL;
+    }
+};
+
+}  // namespace OpenHornet
+
+#endif